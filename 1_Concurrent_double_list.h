@@ -0,0 +1,729 @@
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+/* Concurrent_double_list<Type>
+	A lock-free doubly linked deque that many threads can use at the same time, with the
+	push_front, push_back, pop_front and pop_back operations of Double_sentinel_list.
+	It implements the CAS-based deque of M. M. Michael (Euro-Par 2003): the two ends of the
+	list are kept in a single anchor word (leftmost node, rightmost node and a status), so
+	every operation is one compare-and-swap on the anchor, followed by a short
+	stabilization step that fixes the link of the previous end node after a push.
+	Threads that find the list unstable help to stabilize it before retrying.
+
+	To fit the anchor in one 64-bit word the nodes are addressed by 31-bit indices into a
+	node pool owned by the list (index 0 is null). The pool grows by segments of doubling
+	size and is only returned to the system by the destructor. Popped nodes are recycled
+	through the pool once no thread holds a hazard pointer to them (Michael, 2004), which
+	also protects the anchor from ABA.
+
+	pop_front() and pop_back() return false when the list is empty instead of throwing,
+	since another thread may empty the list between a call to empty() and the pop.
+	size() is exact only when no other thread is modifying the list.
+*/
+
+template <typename Type>
+class Concurrent_double_list {
+	public:
+
+		// Constructors
+
+		Concurrent_double_list();
+		Concurrent_double_list( Concurrent_double_list const & ) = delete;
+		Concurrent_double_list &operator=( Concurrent_double_list const & ) = delete;
+		~Concurrent_double_list();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+
+		// Mutators
+
+		void push_front( Type const & );
+		void push_front( Type && );
+		void push_back( Type const & );
+		void push_back( Type && );
+
+		bool pop_front( Type & );
+		bool pop_back( Type & );
+
+	private:
+		class Deque_node {
+			public:
+				Deque_node();
+
+				Type *value();
+
+				alignas( Type ) unsigned char node_storage[sizeof( Type )];
+				std::atomic<std::uint32_t> left_node;
+				std::atomic<std::uint32_t> right_node;
+				std::atomic<std::uint32_t> free_next;
+		};
+
+		class Hazard_record {
+			public:
+				Hazard_record();
+
+				std::atomic<std::uint32_t> hazard[2];
+				std::atomic<bool> active;
+				std::vector<std::uint32_t> retired;
+				Hazard_record *next_record;
+		};
+
+		// Anchor layout: left index in bits 0-30, right index in bits 31-61, status in bits 62-63
+		static std::uint64_t const STABLE = 0;
+		static std::uint64_t const RPUSH = 1;
+		static std::uint64_t const LPUSH = 2;
+
+		static int const FIRST_SEGMENT = 64;
+		static int const MAX_SEGMENTS = 26;
+
+		std::atomic<std::uint64_t> list_anchor;
+		std::atomic<int> list_size;
+
+		std::atomic<Deque_node *> pool_segments[MAX_SEGMENTS];
+		std::atomic<std::uint32_t> pool_fresh;
+		std::atomic<std::uint64_t> pool_free;
+		std::atomic<Hazard_record *> hazard_records;
+		std::atomic<int> hazard_count;
+
+		static std::uint64_t anchor( std::uint32_t, std::uint32_t, std::uint64_t );
+		static std::uint32_t left_of( std::uint64_t );
+		static std::uint32_t right_of( std::uint64_t );
+		static std::uint64_t status_of( std::uint64_t );
+
+		template <typename Arg>
+		void push_right( Arg && );
+		template <typename Arg>
+		void push_left( Arg && );
+		void stabilize( std::uint64_t, Hazard_record * );
+		void stabilize_right( std::uint64_t, Hazard_record * );
+		void stabilize_left( std::uint64_t, Hazard_record * );
+
+		Deque_node &node( std::uint32_t ) const;
+		std::uint32_t allocate_node();
+		void free_node( std::uint32_t );
+
+		Hazard_record *acquire_record();
+		void release_record( Hazard_record * );
+		void retire_node( std::uint32_t, Hazard_record * );
+		void take_value( std::uint32_t, Hazard_record *, Type & );
+		void scan( Hazard_record * );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+/* Constructor: Concurrent_double_list()
+	This constructor creates an empty list with an empty (stable) anchor and an empty
+	node pool. No memory is allocated until the first push.
+*/
+
+template <typename Type>
+Concurrent_double_list<Type>::Concurrent_double_list():
+list_anchor( anchor( 0, 0, STABLE ) ),
+list_size( 0 ),
+pool_fresh( 1 ),
+pool_free( 0 ),
+hazard_records( nullptr ),
+hazard_count( 0 )
+{
+	for ( int i = 0; i < MAX_SEGMENTS; ++i ) {
+		pool_segments[i].store( nullptr );
+	}
+}
+
+/* Destructor: ~Concurrent_double_list()
+	It destroys the values still in the list, walking the right links from the leftmost
+	node, and then the hazard records and the node pool.
+	No other thread may be using the list.
+*/
+
+template <typename Type>
+Concurrent_double_list<Type>::~Concurrent_double_list() {
+
+	std::uint64_t a = list_anchor.load();
+
+	if ( status_of( a ) != STABLE ) {
+		Hazard_record *helper = acquire_record();
+		stabilize( a, helper );
+		release_record( helper );
+		a = list_anchor.load();
+	}
+
+	for ( std::uint32_t index = left_of( a ); index != 0; ) {
+		Deque_node &current_node = node( index );
+		current_node.value()->~Type();
+		index = ( index == right_of( a ) ) ? 0 : current_node.right_node.load();
+	}
+
+	Hazard_record *record = hazard_records.load();
+	while ( record != nullptr ) {
+		Hazard_record *temp_record = record;
+		record = record->next_record;
+		delete temp_record;
+	}
+
+	for ( int i = 0; i < MAX_SEGMENTS; ++i ) {
+		delete [] pool_segments[i].load();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+/* Accessor: size()
+	This function returns the number of values in the list. While other threads push or
+	pop, the result is only a snapshot.
+*/
+
+template <typename Type>
+int Concurrent_double_list<Type>::size() const {
+	return list_size.load();
+}
+
+/* Accessor: empty()
+	This function returns true if the anchor is empty at the time of the call
+*/
+
+template <typename Type>
+bool Concurrent_double_list<Type>::empty() const {
+	return ( right_of( list_anchor.load() ) == 0 );
+}
+
+/* Mutator: push_front( obj )
+	This mutator inserts a copy of obj (or moves obj) at the front of the list
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::push_front( Type const &obj ) {
+	push_left( obj );
+}
+
+template <typename Type>
+void Concurrent_double_list<Type>::push_front( Type &&obj ) {
+	push_left( std::move( obj ) );
+}
+
+/* Mutator: push_back( obj )
+	This mutator inserts a copy of obj (or moves obj) at the back of the list
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::push_back( Type const &obj ) {
+	push_right( obj );
+}
+
+template <typename Type>
+void Concurrent_double_list<Type>::push_back( Type &&obj ) {
+	push_right( std::move( obj ) );
+}
+
+/* Mutator: pop_back( Type &obj )
+	This mutator removes the last value of the list and moves it into obj.
+	A single node is removed by emptying the anchor. Otherwise, once the anchor is stable,
+	the rightmost node is protected by a hazard pointer so its left link can be read,
+	and the anchor is moved to that left neighbour.
+	It returns false, leaving obj unchanged, if the list is empty.
+	If moving the value into obj throws, the value is lost (it is no longer in the list),
+	and the exception is rethrown after the node is retired.
+*/
+
+template <typename Type>
+bool Concurrent_double_list<Type>::pop_back( Type &obj ) {
+
+	Hazard_record *record = acquire_record();
+	std::uint32_t right;
+
+	while ( true ) {
+		std::uint64_t a = list_anchor.load();
+		std::uint32_t left = left_of( a );
+		right = right_of( a );
+
+		if ( right == 0 ) {
+			release_record( record );
+			return false;
+		}
+
+		if ( right == left ) {
+			if ( list_anchor.compare_exchange_weak( a, anchor( 0, 0, status_of( a ) ) ) ) break;
+		}
+		else if ( status_of( a ) == STABLE ) {
+			record->hazard[0].store( right );
+			if ( list_anchor.load() != a ) continue;
+
+			std::uint32_t previous = node( right ).left_node.load();
+			if ( list_anchor.compare_exchange_weak( a, anchor( left, previous, STABLE ) ) ) break;
+		}
+		else {
+			stabilize( a, record );
+		}
+	}
+
+	take_value( right, record, obj );
+	return true;
+}
+
+/* Mutator: pop_front( Type &obj )
+	This mutator removes the first value of the list and moves it into obj.
+	It is the mirror image of pop_back().
+	It returns false, leaving obj unchanged, if the list is empty.
+*/
+
+template <typename Type>
+bool Concurrent_double_list<Type>::pop_front( Type &obj ) {
+
+	Hazard_record *record = acquire_record();
+	std::uint32_t left;
+
+	while ( true ) {
+		std::uint64_t a = list_anchor.load();
+		std::uint32_t right = right_of( a );
+		left = left_of( a );
+
+		if ( left == 0 ) {
+			release_record( record );
+			return false;
+		}
+
+		if ( right == left ) {
+			if ( list_anchor.compare_exchange_weak( a, anchor( 0, 0, status_of( a ) ) ) ) break;
+		}
+		else if ( status_of( a ) == STABLE ) {
+			record->hazard[0].store( left );
+			if ( list_anchor.load() != a ) continue;
+
+			std::uint32_t next = node( left ).right_node.load();
+			if ( list_anchor.compare_exchange_weak( a, anchor( next, right, STABLE ) ) ) break;
+		}
+		else {
+			stabilize( a, record );
+		}
+	}
+
+	take_value( left, record, obj );
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+/* Private member functions: anchor( left, right, status ), left_of, right_of, status_of
+	These functions pack and unpack the anchor word
+*/
+
+template <typename Type>
+std::uint64_t Concurrent_double_list<Type>::anchor( std::uint32_t left, std::uint32_t right, std::uint64_t status ) {
+	return std::uint64_t( left ) | ( std::uint64_t( right ) << 31 ) | ( status << 62 );
+}
+
+template <typename Type>
+std::uint32_t Concurrent_double_list<Type>::left_of( std::uint64_t a ) {
+	return std::uint32_t( a & 0x7fffffff );
+}
+
+template <typename Type>
+std::uint32_t Concurrent_double_list<Type>::right_of( std::uint64_t a ) {
+	return std::uint32_t( ( a >> 31 ) & 0x7fffffff );
+}
+
+template <typename Type>
+std::uint64_t Concurrent_double_list<Type>::status_of( std::uint64_t a ) {
+	return a >> 62;
+}
+
+/* Private member function: push_right( obj )
+	This function constructs a node storing obj and swings the anchor to it.
+	On an empty list both ends of the anchor point to the new node. Otherwise the new
+	node is linked to the current rightmost node and the anchor is marked RPUSH until
+	the right link of the old rightmost node is set by stabilize_right().
+	If the anchor is not stable, the pending push is stabilized first.
+*/
+
+template <typename Type>
+template <typename Arg>
+void Concurrent_double_list<Type>::push_right( Arg &&obj ) {
+
+	std::uint32_t index = allocate_node();
+	Deque_node &new_node = node( index );
+
+	try {
+		new ( new_node.node_storage ) Type( std::forward<Arg>( obj ) );
+	}
+	catch ( ... ) {
+		free_node( index );
+		throw;
+	}
+
+	new_node.right_node.store( 0 );
+	Hazard_record *record = acquire_record();
+
+	while ( true ) {
+		std::uint64_t a = list_anchor.load();
+		std::uint32_t left = left_of( a );
+		std::uint32_t right = right_of( a );
+
+		if ( right == 0 ) {
+			new_node.left_node.store( 0 );
+			if ( list_anchor.compare_exchange_weak( a, anchor( index, index, status_of( a ) ) ) ) break;
+		}
+		else if ( status_of( a ) == STABLE ) {
+			new_node.left_node.store( right );
+			std::uint64_t pushed = anchor( left, index, RPUSH );
+			if ( list_anchor.compare_exchange_weak( a, pushed ) ) {
+				stabilize_right( pushed, record );
+				break;
+			}
+		}
+		else {
+			stabilize( a, record );
+		}
+	}
+
+	list_size.fetch_add( 1 );
+	release_record( record );
+}
+
+/* Private member function: push_left( obj )
+	This function is the mirror image of push_right()
+*/
+
+template <typename Type>
+template <typename Arg>
+void Concurrent_double_list<Type>::push_left( Arg &&obj ) {
+
+	std::uint32_t index = allocate_node();
+	Deque_node &new_node = node( index );
+
+	try {
+		new ( new_node.node_storage ) Type( std::forward<Arg>( obj ) );
+	}
+	catch ( ... ) {
+		free_node( index );
+		throw;
+	}
+
+	new_node.left_node.store( 0 );
+	Hazard_record *record = acquire_record();
+
+	while ( true ) {
+		std::uint64_t a = list_anchor.load();
+		std::uint32_t left = left_of( a );
+		std::uint32_t right = right_of( a );
+
+		if ( left == 0 ) {
+			new_node.right_node.store( 0 );
+			if ( list_anchor.compare_exchange_weak( a, anchor( index, index, status_of( a ) ) ) ) break;
+		}
+		else if ( status_of( a ) == STABLE ) {
+			new_node.right_node.store( left );
+			std::uint64_t pushed = anchor( index, right, LPUSH );
+			if ( list_anchor.compare_exchange_weak( a, pushed ) ) {
+				stabilize_left( pushed, record );
+				break;
+			}
+		}
+		else {
+			stabilize( a, record );
+		}
+	}
+
+	list_size.fetch_add( 1 );
+	release_record( record );
+}
+
+/* Private member function: stabilize( a, record )
+	This function completes the push recorded in the anchor a
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::stabilize( std::uint64_t a, Hazard_record *record ) {
+
+	if ( status_of( a ) == RPUSH ) {
+		stabilize_right( a, record );
+	}
+	else {
+		stabilize_left( a, record );
+	}
+}
+
+/* Private member function: stabilize_right( a, record )
+	This function sets the right link of the node before the new rightmost node, and then
+	marks the anchor as stable. Both nodes are protected with hazard pointers, and the
+	function gives up as soon as the anchor changes, since then another thread finished it.
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::stabilize_right( std::uint64_t a, Hazard_record *record ) {
+
+	std::uint32_t right = right_of( a );
+
+	record->hazard[0].store( right );
+	if ( list_anchor.load() != a ) return;
+
+	std::uint32_t previous = node( right ).left_node.load();
+	record->hazard[1].store( previous );
+	if ( list_anchor.load() != a ) return;
+
+	std::uint32_t previous_next = node( previous ).right_node.load();
+
+	if ( previous_next != right ) {
+		if ( list_anchor.load() != a ) return;
+		if ( !node( previous ).right_node.compare_exchange_strong( previous_next, right ) ) return;
+	}
+
+	list_anchor.compare_exchange_strong( a, anchor( left_of( a ), right, STABLE ) );
+}
+
+/* Private member function: stabilize_left( a, record )
+	This function is the mirror image of stabilize_right()
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::stabilize_left( std::uint64_t a, Hazard_record *record ) {
+
+	std::uint32_t left = left_of( a );
+
+	record->hazard[0].store( left );
+	if ( list_anchor.load() != a ) return;
+
+	std::uint32_t next = node( left ).right_node.load();
+	record->hazard[1].store( next );
+	if ( list_anchor.load() != a ) return;
+
+	std::uint32_t next_previous = node( next ).left_node.load();
+
+	if ( next_previous != left ) {
+		if ( list_anchor.load() != a ) return;
+		if ( !node( next ).left_node.compare_exchange_strong( next_previous, left ) ) return;
+	}
+
+	list_anchor.compare_exchange_strong( a, anchor( left, right_of( a ), STABLE ) );
+}
+
+/* Private member function: node( index )
+	This function returns the node with the given (non-zero) index.
+	Segment s holds FIRST_SEGMENT*2^s nodes, so the segment is found from the leading bit.
+*/
+
+template <typename Type>
+typename Concurrent_double_list<Type>::Deque_node &Concurrent_double_list<Type>::node( std::uint32_t index ) const {
+
+	std::uint32_t position = index - 1;
+	std::uint32_t block = position/FIRST_SEGMENT + 1;
+	int segment = 31 - __builtin_clz( block );
+	std::uint32_t offset = position - FIRST_SEGMENT*( ( 1u << segment ) - 1 );
+
+	return pool_segments[segment].load( std::memory_order_acquire )[offset];
+}
+
+/* Private member function: allocate_node()
+	This function pops a recycled node from the free list of the pool, or takes a new index
+	and allocates its segment if no thread has done it yet.
+	The free list head carries a counter in its high 32 bits to avoid ABA.
+	Throws overflow if the 31-bit index space is exhausted
+*/
+
+template <typename Type>
+std::uint32_t Concurrent_double_list<Type>::allocate_node() {
+
+	std::uint64_t head = pool_free.load();
+
+	while ( std::uint32_t( head ) != 0 ) {
+		std::uint32_t index = std::uint32_t( head );
+		std::uint64_t next = ( head & 0xffffffff00000000ull ) + ( 1ull << 32 ) + node( index ).free_next.load();
+
+		if ( pool_free.compare_exchange_weak( head, next ) ) return index;
+	}
+
+	std::uint32_t index = pool_fresh.fetch_add( 1 );
+	if ( index > 0x7fffffff ) throw overflow();
+
+	int segment = 31 - __builtin_clz( ( index - 1 )/FIRST_SEGMENT + 1 );
+
+	if ( pool_segments[segment].load() == nullptr ) {
+		Deque_node *memory = new Deque_node[FIRST_SEGMENT << segment];
+		Deque_node *expected = nullptr;
+
+		if ( !pool_segments[segment].compare_exchange_strong( expected, memory ) ) {
+			delete [] memory;
+		}
+	}
+
+	return index;
+}
+
+/* Private member function: free_node( index )
+	This function pushes a node that no thread can reach on the free list of the pool
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::free_node( std::uint32_t index ) {
+
+	std::uint64_t head = pool_free.load();
+
+	do {
+		node( index ).free_next.store( std::uint32_t( head ) );
+	} while ( !pool_free.compare_exchange_weak( head, ( head & 0xffffffff00000000ull ) + ( 1ull << 32 ) + index ) );
+}
+
+/* Private member function: acquire_record()
+	This function gives the calling thread an inactive hazard record for one operation,
+	or links a new record to the list of records if all of them are in use
+*/
+
+template <typename Type>
+typename Concurrent_double_list<Type>::Hazard_record *Concurrent_double_list<Type>::acquire_record() {
+
+	for ( Hazard_record *record = hazard_records.load(); record != nullptr; record = record->next_record ) {
+		if ( !record->active.load( std::memory_order_relaxed ) and !record->active.exchange( true ) ) {
+			return record;
+		}
+	}
+
+	Hazard_record *record = new Hazard_record;
+	record->active.store( true );
+	record->next_record = hazard_records.load();
+
+	while ( !hazard_records.compare_exchange_weak( record->next_record, record ) );
+
+	hazard_count.fetch_add( 1 );
+	return record;
+}
+
+/* Private member function: release_record( record )
+	This function clears the hazard pointers of the record and makes it available again.
+	Retired nodes stay in the record until a later scan can reclaim them.
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::release_record( Hazard_record *record ) {
+
+	record->hazard[0].store( 0 );
+	record->hazard[1].store( 0 );
+	record->active.store( false, std::memory_order_release );
+}
+
+/* Private member function: retire_node( index, record )
+	This function adds a popped node to the retired nodes of the record, and scans the
+	hazard pointers once there are enough retired nodes to amortize the scan
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::retire_node( std::uint32_t index, Hazard_record *record ) {
+
+	record->retired.push_back( index );
+
+	if ( int( record->retired.size() ) >= 4*hazard_count.load() + 16 ) {
+		scan( record );
+	}
+}
+
+/* Private member function: take_value( index, record, obj )
+	This function ends a pop: it moves the value of the node index, which the caller has
+	removed from the list, into obj, destroys it, retires the node and releases the record.
+	The node is retired and the record released even if the move assignment throws, so
+	neither leaks; the exception is then rethrown.
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::take_value( std::uint32_t index, Hazard_record *record, Type &obj ) {
+
+	Type *value = node( index ).value();
+	std::exception_ptr failure;
+
+	try {
+		obj = std::move( *value );
+	}
+	catch ( ... ) {
+		failure = std::current_exception();
+	}
+
+	value->~Type();
+	list_size.fetch_sub( 1 );
+
+	retire_node( index, record );
+	release_record( record );
+
+	if ( failure ) std::rethrow_exception( failure );
+}
+
+/* Private member function: scan( record )
+	This function collects the hazard pointers of every record and returns to the pool
+	the retired nodes of the record that are not protected by any of them
+*/
+
+template <typename Type>
+void Concurrent_double_list<Type>::scan( Hazard_record *record ) {
+
+	std::vector<std::uint32_t> hazards;
+
+	for ( Hazard_record *other = hazard_records.load(); other != nullptr; other = other->next_record ) {
+		for ( int i = 0; i < 2; ++i ) {
+			std::uint32_t index = other->hazard[i].load();
+			if ( index != 0 ) hazards.push_back( index );
+		}
+	}
+
+	std::sort( hazards.begin(), hazards.end() );
+
+	std::vector<std::uint32_t> kept;
+
+	for ( std::uint32_t index : record->retired ) {
+		if ( std::binary_search( hazards.begin(), hazards.end(), index ) ) {
+			kept.push_back( index );
+		}
+		else {
+			free_node( index );
+		}
+	}
+
+	record->retired.swap( kept );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                 Node and Hazard record functions                    //
+/////////////////////////////////////////////////////////////////////////
+
+/* Node Constructor: Deque_node()
+	This constructor creates an unlinked node with no value
+*/
+
+template <typename Type>
+Concurrent_double_list<Type>::Deque_node::Deque_node():
+left_node( 0 ),
+right_node( 0 ),
+free_next( 0 )
+{ }
+
+/* Member function: value()
+	This member function returns the address of the value stored in the node
+*/
+
+template <typename Type>
+Type *Concurrent_double_list<Type>::Deque_node::value() {
+
+	return std::launder( reinterpret_cast<Type *>( node_storage ) );
+}
+
+/* Hazard record Constructor: Hazard_record()
+	This constructor creates an inactive record without hazard pointers
+*/
+
+template <typename Type>
+Concurrent_double_list<Type>::Hazard_record::Hazard_record():
+active( false ),
+next_record( nullptr )
+{
+	hazard[0].store( 0 );
+	hazard[1].store( 0 );
+}
@@ -0,0 +1,175 @@
+// Throughput and latency benchmark of Concurrent_double_list against Double_sentinel_list
+// behind a std::mutex (the wrapper it replaces), at 1 to 32 threads.
+//
+// Build:	g++ -std=c++17 -O2 -pthread 1_Concurrent_double_list_benchmark.cpp -o list_benchmark
+// Run:		./list_benchmark [pairs per thread (default 1000000)] [maximum threads (default 32)]
+//
+// Every thread performs a number of pairs of operations on a shared list that starts with
+// 1024 values: a push followed by a pop. Two workloads are run:
+//	queue	push_back and pop_front, so the threads meet at both ends
+//	deque	push and pop at an end chosen at random for each operation
+// The throughput is the number of operations per second for all the threads; the latency
+// of one pair in SAMPLE_EVERY is measured, and the median, 99th and 99.9th percentiles are
+// printed (in nanoseconds).
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The exceptions thrown by the lists
+class underflow {};
+class overflow {};
+class illegal_argument {};
+
+#include "1_Double_sentinel_list.h"
+#include "1_Concurrent_double_list.h"
+
+/*
+	Locked_list is the baseline: a Double_sentinel_list protected by a mutex, with the
+	interface of Concurrent_double_list (the pops return false when the list is empty)
+*/
+class Locked_list {
+	public:
+		void push_front( std::uint64_t value ) {
+			std::lock_guard<std::mutex> lock( list_mutex );
+			list.push_front( value );
+		}
+
+		void push_back( std::uint64_t value ) {
+			std::lock_guard<std::mutex> lock( list_mutex );
+			list.push_back( value );
+		}
+
+		bool pop_front( std::uint64_t &value ) {
+			std::lock_guard<std::mutex> lock( list_mutex );
+			if ( list.empty() ) return false;
+			value = list.front();
+			list.pop_front();
+			return true;
+		}
+
+		bool pop_back( std::uint64_t &value ) {
+			std::lock_guard<std::mutex> lock( list_mutex );
+			if ( list.empty() ) return false;
+			value = list.back();
+			list.pop_back();
+			return true;
+		}
+
+	private:
+		Double_sentinel_list<std::uint64_t> list;
+		std::mutex list_mutex;
+};
+
+class Result {
+	public:
+		double operations_per_second;
+		std::uint64_t median;
+		std::uint64_t p99;
+		std::uint64_t p999;
+};
+
+static std::uint64_t now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static int const SAMPLE_EVERY = 16;
+static int const INITIAL_SIZE = 1024;
+
+/*
+	work performs count push/pop pairs; with random_ends, each operation takes the end given
+	by one bit of a random number, otherwise it pushes at the back and pops at the front
+*/
+template <typename List>
+void work( List &list, long count, bool random_ends, unsigned seed, std::vector<std::uint64_t> &latencies ) {
+	std::mt19937 random( seed );
+	std::uint32_t bits = 0;
+	std::uint64_t value;
+
+	for ( long i = 0; i < count; ++i ) {
+		if ( i % 16 == 0 ) bits = random();
+		bool sample = ( i % SAMPLE_EVERY == 0 );
+		std::uint64_t start = sample ? now() : 0;
+
+		if ( !random_ends or ( bits & 1 ) ) list.push_back( i );
+		else list.push_front( i );
+
+		if ( random_ends and ( bits & 2 ) ) list.pop_back( value );
+		else list.pop_front( value );
+
+		if ( sample ) latencies.push_back( now() - start );
+		bits >>= 2;
+	}
+}
+
+/*
+	run performs count pairs in each of the threads on list
+*/
+template <typename List>
+Result run( List &list, int threads, long count, bool random_ends ) {
+	for ( int i = 0; i < INITIAL_SIZE; ++i ) list.push_back( i );
+
+	std::vector<std::vector<std::uint64_t>> latencies( threads );
+	std::vector<std::thread> pool;
+	std::uint64_t start = now();
+
+	for ( int i = 0; i < threads; ++i ) {
+		pool.emplace_back( [&, i]{ work( list, count, random_ends, 1 + i, latencies[i] ); } );
+	}
+	for ( auto &thread: pool ) thread.join();
+
+	double seconds = ( now() - start )*1e-9;
+
+	std::vector<std::uint64_t> all;
+	for ( auto const &sample: latencies ) all.insert( all.end(), sample.begin(), sample.end() );
+	std::sort( all.begin(), all.end() );
+
+	Result result;
+	result.operations_per_second = 2.0*threads*count/seconds;
+	result.median = all.empty() ? 0 : all[all.size()/2];
+	result.p99 = all.empty() ? 0 : all[all.size()*99/100];
+	result.p999 = all.empty() ? 0 : all[all.size()*999/1000];
+	return result;
+}
+
+static void print( std::string const &name, std::string const &workload, int threads, Result const &result ) {
+	std::cout << std::left << std::setw( 14 ) << name << std::setw( 8 ) << workload << std::right
+	          << std::setw( 8 ) << threads
+	          << std::setw( 14 ) << std::fixed << std::setprecision( 2 ) << result.operations_per_second/1e6
+	          << std::setw( 12 ) << result.median
+	          << std::setw( 12 ) << result.p99
+	          << std::setw( 12 ) << result.p999 << std::endl;
+}
+
+int main( int argc, char **argv ) {
+	long count = ( argc > 1 ) ? std::atol( argv[1] ) : 1000000;
+	int max_threads = ( argc > 2 ) ? std::atoi( argv[2] ) : 32;
+
+	std::cout << std::left << std::setw( 14 ) << "list" << std::setw( 8 ) << "work" << std::right
+	          << std::setw( 8 ) << "threads" << std::setw( 14 ) << "Mops/s" << std::setw( 12 ) << "p50 ns"
+	          << std::setw( 12 ) << "p99 ns" << std::setw( 12 ) << "p99.9 ns" << std::endl;
+
+	for ( int threads = 1; threads <= max_threads; threads *= 2 ) {
+		for ( bool random_ends: { false, true } ) {
+			std::string workload = random_ends ? "deque" : "queue";
+			{
+				Locked_list list;
+				print( "mutex list", workload, threads, run( list, threads, count, random_ends ) );
+			}
+			{
+				Concurrent_double_list<std::uint64_t> list;
+				print( "lock-free", workload, threads, run( list, threads, count, random_ends ) );
+			}
+		}
+	}
+
+	return 0;
+}
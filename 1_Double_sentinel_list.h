@@ -1,13 +1,113 @@
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+/* Allocator policy: New_node_allocator
+	This is the default node allocator of Double_sentinel_list. Every node is
+	obtained with the global operator new and released with the global operator delete.
+	Any allocator policy must provide allocate( bytes ) and deallocate( address, bytes ),
+	reserve( bytes, n ), a hint that n blocks of that size are about to be allocated,
+	and operator== returning true when one allocator can release the nodes of the other.
+*/
+
+class New_node_allocator {
+	public:
+		void *allocate( std::size_t );
+		void deallocate( void *, std::size_t );
+		void reserve( std::size_t, int );
+
+		bool operator==( New_node_allocator const & ) const;
+		bool operator!=( New_node_allocator const & ) const;
+};
+
+/* Node_pool
+	A slab/free-list pool of fixed-size blocks. Memory is requested from the system in
+	slabs of slab_blocks blocks and handed out one block at a time. Released blocks are
+	pushed on a LIFO free list, so the most recently freed (cache-warm) node is the
+	first one to be reused. The block size is fixed by the first allocation; requests
+	of any other size are forwarded to the global operator new.
+	The memory of the slabs is only returned to the system when the pool is destroyed.
+*/
+
+class Node_pool {
+	public:
+		Node_pool( int = 64 );
+		Node_pool( Node_pool const & ) = delete;
+		Node_pool &operator=( Node_pool const & ) = delete;
+		~Node_pool();
+
+		// Accessors
+
+		int capacity() const;
+		int available() const;
+
+		// Mutators
+
+		void *allocate( std::size_t );
+		void deallocate( void *, std::size_t );
+		void reserve( std::size_t, int );
+
+	private:
+		struct Free_block {
+			Free_block *next_block;
+		};
+
+		struct Slab {
+			Slab *next_slab;
+		};
+
+		std::size_t block_size;
+		int slab_blocks;
+		int pool_capacity;
+		int pool_available;
+		Slab *slab_list;
+		Free_block *free_list;
+
+		static std::size_t round_up( std::size_t );
+		void grow( int );
+};
+
+/* Allocator policy: Pool_node_allocator
+	Node allocator policy that takes the nodes from a Node_pool. A default constructed
+	allocator creates its own pool. Copies of an allocator share the same pool, so several
+	lists can recycle each other's nodes by constructing them with the same allocator
+	or with the same std::shared_ptr<Node_pool>.
+*/
+
+class Pool_node_allocator {
+	public:
+		Pool_node_allocator( int = 64 );
+		Pool_node_allocator( std::shared_ptr<Node_pool> const & );
+
+		std::shared_ptr<Node_pool> pool() const;
+
+		void *allocate( std::size_t );
+		void deallocate( void *, std::size_t );
+		void reserve( std::size_t, int );
+
+		bool operator==( Pool_node_allocator const & ) const;
+		bool operator!=( Pool_node_allocator const & ) const;
+
+	private:
+		std::shared_ptr<Node_pool> node_pool;
+};
 
-template <typename Type>
+template <typename Type, typename Alloc = New_node_allocator>
 class Double_sentinel_list {
 	public:
 		class Double_node {
 			public:
 				Double_node( Type const & = Type(), Double_node * = nullptr, Double_node * = nullptr );
+				template <typename... Args>
+				Double_node( Double_node *, Double_node *, Args &&... );
 
-				Type value() const;
+				Type &value();
+				Type const &value() const;
 				Double_node *previous() const;
 				Double_node *next() const;
 
@@ -18,7 +118,7 @@ class Double_sentinel_list {
 
 		// Constructors
 
-		Double_sentinel_list();
+		Double_sentinel_list( Alloc const & = Alloc() );
 		Double_sentinel_list( Double_sentinel_list const & );
 		Double_sentinel_list( Double_sentinel_list && );
 		~Double_sentinel_list();
@@ -27,9 +127,12 @@ class Double_sentinel_list {
 
 		int size() const;
 		bool empty() const;
+		Alloc get_allocator() const;
 
-		Type front() const;
-		Type back() const;
+		Type &front();
+		Type const &front() const;
+		Type &back();
+		Type const &back() const;
 
 		Double_node *begin() const;
 		Double_node *end() const;
@@ -39,44 +142,84 @@ class Double_sentinel_list {
 		Double_node *find( Type const & ) const;
 		int count( Type const & ) const;
 
+		template <typename... Predicates>
+		std::array<int, sizeof...( Predicates )> count_if_many( Predicates... ) const;
+		template <typename Iterator>
+		Double_node *find_first_of( Iterator, Iterator ) const;
+		Double_node *find_first_of( std::initializer_list<Type> ) const;
+
 		// Mutators
 
 		void swap( Double_sentinel_list & );
-		Double_sentinel_list &operator=( Double_sentinel_list );
+		Double_sentinel_list &operator=( Double_sentinel_list const & );
 		Double_sentinel_list &operator=( Double_sentinel_list && );
 
 		void push_front( Type const & );
+		void push_front( Type && );
 		void push_back( Type const & );
+		void push_back( Type && );
+
+		template <typename... Args>
+		Type &emplace_front( Args &&... );
+		template <typename... Args>
+		Type &emplace_back( Args &&... );
+		template <typename... Args>
+		Double_node *emplace( Double_node *, Args &&... );
 
 		void pop_front();
 		void pop_back();
 
 		int erase( Type const & );
+		Double_node *erase( Double_node * );
+
+		void splice( Double_node *, Double_sentinel_list & );
+		void splice( Double_node *, Double_sentinel_list &, Double_node * );
+		void splice( Double_node *, Double_sentinel_list &, Double_node *, Double_node * );
+		template <typename Iterator>
+		Double_node *insert_range( Double_node *, Iterator, Iterator );
+		void append( Double_sentinel_list && );
 
 	private:
 		Double_node *list_head;
 		Double_node *list_tail;
 		int list_size;
+		Alloc list_allocator;
+
+		template <typename... Args>
+		Double_node *create_node( Double_node *, Double_node *, Args &&... );
+		template <typename... Args>
+		Double_node *insert_node( Double_node *, Args &&... );
+		void destroy_node( Double_node * );
+		static void unlink_chain( Double_node *, Double_node * );
+		static void link_chain( Double_node *, Double_node *, Double_node * );
+
+		static int const PREFETCH_DISTANCE = 4;
+
+		template <typename Visitor>
+		Double_node *traverse( Visitor ) const;
+		static void prefetch( Double_node const * );
 };
 
 /////////////////////////////////////////////////////////////////////////
 //                      Public member functions                        //
 /////////////////////////////////////////////////////////////////////////
 
-/* Default Constructor: Double_sentinel_list()
+/* Default Constructor: Double_sentinel_list( alloc )
 	This is the default constructor that creates the head and tail sentinel nodes
 	head -> Head sentinel node
 	tail -> Tail sentinel node
+	alloc -> Allocator policy used for every node of the list (sentinels included)
 	This constructor assumes that the created list is new
 	No errors are expected with this constructor
 */
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_sentinel_list():
-list_size( 0 )
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc>::Double_sentinel_list( Alloc const &alloc ):
+list_size( 0 ),
+list_allocator( alloc )
 {
-	Double_node *head = new Double_node;
-	Double_node *tail = new Double_node;
+	Double_node *head = create_node( nullptr, nullptr );
+	Double_node *tail = create_node( nullptr, nullptr );
 	head->next_node = tail;
 	head->previous_node = nullptr;
 	tail->previous_node = head;
@@ -85,42 +228,57 @@ list_size( 0 )
 	list_tail = tail;
 }
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_sentinel_list( Double_sentinel_list<Type> const &list ):
-list_head( nullptr ),
-list_tail( nullptr ),
-list_size( 0 )
-{ }
+/* Copy Constructor: Double_sentinel_list( list )
+	This constructor creates a deep copy of list, sharing its allocator policy.
+	The allocator is told up front how many nodes are coming, so with a Pool_node_allocator
+	all of them are carved out of a single slab (one request to the system instead of n),
+	and the nodes are linked in one pass from front to back.
+	If copying a value throws, the delegated constructor has already completed, so the
+	destructor releases the nodes created so far.
+*/
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_sentinel_list( Double_sentinel_list<Type> &&list ):
-list_head( nullptr ),
-list_tail( nullptr ),
-list_size( 0 )
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc>::Double_sentinel_list( Double_sentinel_list<Type, Alloc> const &list ):
+Double_sentinel_list( list.list_allocator )
 {
-	this->swap(list);
+	list_allocator.reserve( sizeof( Double_node ), list.list_size );
+
+	for ( Double_node *node = list.list_head->next_node; node != list.list_tail; node = node->next_node ) {
+		insert_node( list_tail, node->node_value );
+	}
+}
+
+/* Move Constructor: Double_sentinel_list( list )
+	This constructor takes the nodes of list in O(1). The argument is left as a valid
+	empty list with its own sentinels, so it can still be used or assigned to.
+*/
+
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc>::Double_sentinel_list( Double_sentinel_list<Type, Alloc> &&list ):
+Double_sentinel_list( list.list_allocator )
+{
+	swap( list );
 }
 
 /* Destructor: ~Double_sentinel_list()
-	It deletes all the nodes in the list, including the sentinels.
+	It deletes all the nodes in the list, including the sentinels, through the allocator policy.
 	list_head -> Head sentinel node
 	list_tail -> Tail sentinel node
 	current_node -> It will go through the whole list to delete all nodes
 	temp_node -> It is the node that will delete each node at a time
-	This destructor always expect at least 2 nodes (sentinels)
+	The walk stops at the null link after the tail sentinel
 	No errors are expected with this destructor
 */
 
-template <typename Type>
-Double_sentinel_list<Type>::~Double_sentinel_list() {
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc>::~Double_sentinel_list() {
 
 	Double_node *current_node = this->list_head;
-	while ( current_node != list_tail ) {
+	while ( current_node != nullptr ) {
 		Double_node *temp_node = current_node;
 		current_node = current_node->next_node;
-		delete temp_node;
+		destroy_node( temp_node );
 	}
-	delete current_node;
 }
 
 /* Accessor: size()
@@ -130,8 +288,8 @@ Double_sentinel_list<Type>::~Double_sentinel_list() {
 	No errors are expected with this accessor
 */
 
-template <typename Type>
-int Double_sentinel_list<Type>::size() const {
+template <typename Type, typename Alloc>
+int Double_sentinel_list<Type, Alloc>::size() const {
 	return list_size;
 }
 
@@ -142,8 +300,8 @@ int Double_sentinel_list<Type>::size() const {
 	No errors are expected with this accessor
 */
 
-template <typename Type>
-bool Double_sentinel_list<Type>::empty() const {
+template <typename Type, typename Alloc>
+bool Double_sentinel_list<Type, Alloc>::empty() const {
 	if ( this->size() == 0 ){
 		return true;
 	}
@@ -152,32 +310,56 @@ bool Double_sentinel_list<Type>::empty() const {
 	}
 }
 
+/* Accessor: get_allocator()
+	This function returns a copy of the allocator policy used by the list
+	Lists sharing a Pool_node_allocator can be created from this copy
+*/
+
+template <typename Type, typename Alloc>
+Alloc Double_sentinel_list<Type, Alloc>::get_allocator() const {
+	return list_allocator;
+}
+
 /* Accessor: front()
-	This function returns the object stored in the first/front node
+	This function returns a reference to the object stored in the first/front node
 	empty() -> member function
 	This accessor assumes that the list has at least one element
 	Throws underflow if the list is empty
 */
 
-template <typename Type>
-Type Double_sentinel_list<Type>::front() const {
+template <typename Type, typename Alloc>
+Type &Double_sentinel_list<Type, Alloc>::front() {
+	if ( this->empty() ) throw underflow();
+
+	return this->list_head->next_node->node_value;
+}
+
+template <typename Type, typename Alloc>
+Type const &Double_sentinel_list<Type, Alloc>::front() const {
 	if ( this->empty() ) throw underflow();
 
 	return this->list_head->next_node->node_value;
 }
 
 /* Accessor: back()
-	This function returns the object stored in the last/back node
+	This function returns a reference to the object stored in the last/back node
 	empty() -> member function
 	This accessor assumes that the list has at least one element
 	Throws underflow if the list is empty
 */
 
-template <typename Type>
-Type Double_sentinel_list<Type>::back() const {
+template <typename Type, typename Alloc>
+Type &Double_sentinel_list<Type, Alloc>::back() {
+	if ( this->empty() ) throw underflow();
+
+	return this->list_tail->previous_node->node_value;
+}
+
+template <typename Type, typename Alloc>
+Type const &Double_sentinel_list<Type, Alloc>::back() const {
 	if ( this->empty() ) throw underflow();
 
-	return this->list_tail->previous_node->node_value; 
+	return this->list_tail->previous_node->node_value;
 }
 
 /* Accessor: begin()
@@ -185,8 +367,8 @@ Type Double_sentinel_list<Type>::back() const {
 	This accessor assumes that the list has at least one element
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::begin() const {
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::begin() const {
 	return this->list_head->next_node;
 }
 
@@ -194,8 +376,8 @@ typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::be
 	This function returns the address of the tail sentinel node
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::end() const {
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::end() const {
 	return this->list_tail;
 }
 
@@ -204,8 +386,8 @@ typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::en
 	This accessor assumes that the list has at least one element
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::rbegin() const {
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::rbegin() const {
 	return this->list_tail->previous_node;
 }
 
@@ -213,77 +395,112 @@ typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::rb
 	This function returns the address of the head sentinel
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::rend() const {
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::rend() const {
 	return this->list_head;
 }
 
 /* Accessor: find()
 	This function returns the address of the first node in the list storing a value equal to the argument
-	empty() -> member function
-	end() -> member function
+	traverse() -> private member function
 	It returns end() if non is found.
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::find( Type const &obj ) const {
-
-	if ( this->empty() ) return this->end();
-
-	Double_node *temp = list_head;
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::find( Type const &obj ) const {
 
-	while ( temp->next_node != list_tail and temp->node_value != obj )
-		temp = temp->next_node;
-	if ( temp->node_value == obj ) {
-		return temp;
-	}
-	else {
-		return this->end();
-	}
+	return traverse( [&obj]( Double_node const *node ) {
+		return node->node_value == obj;
+	} );
 }
 
 /* Accessor: count()
 	This function returns the number of nodes in the linked list storing a value equal to the argument
-	empty() -> member function
+	traverse() -> private member function
 	If none in found return 0.
 */
 
-template <typename Type>
-int Double_sentinel_list<Type>::count( Type const &obj ) const {
+template <typename Type, typename Alloc>
+int Double_sentinel_list<Type, Alloc>::count( Type const &obj ) const {
 
 	int cont = 0;
-	if ( this->empty() ) return cont;
 
-	Double_node *temp = list_head;
+	traverse( [&obj, &cont]( Double_node const *node ) {
+		cont += ( node->node_value == obj );
+		return false;
+	} );
 
-	while ( temp != list_tail ) {
-		if ( temp->node_value == obj ){
-			cont += 1;
-		}
-		temp = temp->next_node;
-	}
 	return cont;
 }
 
-/* Mutator: swap( Double_sentinel_list<Type> &list )
+/* Accessor: count_if_many( predicates... )
+	This function evaluates every predicate on every value in a single pass over the list.
+	The i-th entry of the result is the number of values for which the i-th predicate is true,
+	so several counts over the same list cost one walk instead of one walk each.
+	For example, list.count_if_many( is_error, is_warning, is_slow )
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Predicates>
+std::array<int, sizeof...( Predicates )> Double_sentinel_list<Type, Alloc>::count_if_many( Predicates... predicates ) const {
+
+	std::array<int, sizeof...( Predicates )> counts{};
+
+	if constexpr ( sizeof...( Predicates ) > 0 ) {
+		traverse( [&]( Double_node const *node ) {
+			int i = 0;
+			( ( counts[i++] += bool( predicates( node->node_value ) ) ), ... );
+			return false;
+		} );
+	}
+
+	return counts;
+}
+
+/* Accessor: find_first_of( first, last )
+	This function returns the address of the first node storing a value equal to any of the
+	values in [first, last), looking for all of them in a single pass.
+	It returns end() if none is found.
+*/
+
+template <typename Type, typename Alloc>
+template <typename Iterator>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::find_first_of( Iterator first, Iterator last ) const {
+
+	if ( first == last ) return end();
+
+	return traverse( [first, last]( Double_node const *node ) {
+		return std::find( first, last, node->node_value ) != last;
+	} );
+}
+
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::find_first_of( std::initializer_list<Type> values ) const {
+
+	return find_first_of( values.begin(), values.end() );
+}
+
+/* Mutator: swap( Double_sentinel_list<Type, Alloc> &list )
 	This mutator swaps all the member variable of *this linked list with those of the passed argument list
 */
 
-template <typename Type>
-void Double_sentinel_list<Type>::swap( Double_sentinel_list<Type> &list ) {
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::swap( Double_sentinel_list<Type, Alloc> &list ) {
 
 	std::swap( list_head, list.list_head );
 	std::swap( list_tail, list.list_tail );
 	std::swap( list_size, list.list_size );
+	std::swap( list_allocator, list.list_allocator );
 }
 
 /* Mutator: Assignment operator 
 	This assignment operator copies the argument list into the *this list 
 */
-template <typename Type>
-Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentinel_list<Type> rhs ) {
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc> &Double_sentinel_list<Type, Alloc>::operator=( Double_sentinel_list<Type, Alloc> const &rhs ) {
 
-	swap( rhs );
+	Double_sentinel_list<Type, Alloc> copy( rhs );
+	swap( copy );
 
 	return *this;
 }
@@ -291,8 +508,8 @@ Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentin
 /* Mutator: Move operator 
 	This assignment operator moves the nodes of the argument list into *this list, changing the argument list into an empty list
 */
-template <typename Type>
-Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentinel_list<Type> &&rhs ) {
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc> &Double_sentinel_list<Type, Alloc>::operator=( Double_sentinel_list<Type, Alloc> &&rhs ) {
 
 	swap( rhs );
 
@@ -300,35 +517,79 @@ Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentin
 }
 
 /* Mutator: push_front( Type const &obj )
-	This mutator inserts a node, storing obj, at the front of the list.
+	This mutator inserts a node, storing a copy of obj, at the front of the list.
 */
 
-template <typename Type>
-void Double_sentinel_list<Type>::push_front( Type const &obj ) {
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::push_front( Type const &obj ) {
 
-	Double_node *aux = new Double_node;
-	aux->node_value = obj;
-	aux->next_node = list_head->next_node;
-	aux->previous_node = list_head;
-	list_head->next_node->previous_node = aux;
-	list_head->next_node = aux;
-	list_size += 1;
+	insert_node( list_head->next_node, obj );
+}
+
+/* Mutator: push_front( Type &&obj )
+	This mutator inserts a node at the front of the list, moving obj into it.
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::push_front( Type &&obj ) {
+
+	insert_node( list_head->next_node, std::move( obj ) );
 }
 
 /* Mutator: push_back( Type const &obj )
-	This mutator inserts a node, storing obj, at the back of the list.
+	This mutator inserts a node, storing a copy of obj, at the back of the list.
 */
 
-template <typename Type>
-void Double_sentinel_list<Type>::push_back( Type const &obj ) {
-	
-	Double_node *aux = new Double_node;
-	aux->node_value = obj;
-	aux->next_node = list_tail;
-	aux->previous_node = list_tail->previous_node;
-	list_tail->previous_node->next_node = aux;
-	list_tail->previous_node = aux;
-	list_size += 1;
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::push_back( Type const &obj ) {
+
+	insert_node( list_tail, obj );
+}
+
+/* Mutator: push_back( Type &&obj )
+	This mutator inserts a node at the back of the list, moving obj into it.
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::push_back( Type &&obj ) {
+
+	insert_node( list_tail, std::move( obj ) );
+}
+
+/* Mutator: emplace_front( args... )
+	This mutator inserts a node at the front of the list, constructing its value
+	in place from args. It returns a reference to the new value.
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Args>
+Type &Double_sentinel_list<Type, Alloc>::emplace_front( Args &&... args ) {
+
+	return insert_node( list_head->next_node, std::forward<Args>( args )... )->node_value;
+}
+
+/* Mutator: emplace_back( args... )
+	This mutator inserts a node at the back of the list, constructing its value
+	in place from args. It returns a reference to the new value.
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Args>
+Type &Double_sentinel_list<Type, Alloc>::emplace_back( Args &&... args ) {
+
+	return insert_node( list_tail, std::forward<Args>( args )... )->node_value;
+}
+
+/* Mutator: emplace( position, args... )
+	This mutator inserts a node in front of position (a node of this list, or end()),
+	constructing its value in place from args. It returns the address of the new node.
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Args>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::emplace( Double_node *position, Args &&... args ) {
+
+	return insert_node( position, std::forward<Args>( args )... );
 }
 
 /* Mutator: pop_front()
@@ -336,15 +597,15 @@ void Double_sentinel_list<Type>::push_back( Type const &obj ) {
 	Throws underflow() if the list is empty
 */
 
-template <typename Type>
-void Double_sentinel_list<Type>::pop_front() {
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::pop_front() {
 
 	if ( this->empty() ) throw underflow();
 
 	Double_node *rem_node = list_head->next_node;
 	list_head->next_node = rem_node->next_node;
 	rem_node->next_node->previous_node = list_head;
-	delete rem_node;
+	destroy_node( rem_node );
 	list_size -= 1;
 }
 
@@ -353,15 +614,15 @@ void Double_sentinel_list<Type>::pop_front() {
 	Throws underflow() if the list is empty
 */
 
-template <typename Type>
-void Double_sentinel_list<Type>::pop_back() {
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::pop_back() {
 	
 	if ( this->empty() ) throw underflow();
 
 	Double_node *rem_node = list_tail->previous_node;
 	list_tail->previous_node = rem_node->previous_node;
 	rem_node->previous_node->next_node = list_tail;
-	delete rem_node;
+	destroy_node( rem_node );
 	list_size -= 1;
 }
 
@@ -370,33 +631,211 @@ void Double_sentinel_list<Type>::pop_back() {
 	It returns the number of deleted nodes
 */
 
-template <typename Type>
-int Double_sentinel_list<Type>::erase( Type const &obj ) {
+template <typename Type, typename Alloc>
+int Double_sentinel_list<Type, Alloc>::erase( Type const &obj ) {
 	int cont = 0;
-	int aux = 0;
-	if ( this->empty() ) return cont;
-	Double_node *current_node = list_head;
+	Double_node *current_node = list_head->next_node;
 
 	while ( current_node != list_tail ){
 		if ( current_node->node_value == obj ) {
-			Double_node *temp_node = current_node;
-			current_node->previous_node->next_node = temp_node->next_node;
-			current_node->next_node->previous_node = temp_node->previous_node;
-			current_node = current_node->next_node;
-			delete temp_node;
+			current_node = erase( current_node );
 			cont += 1;
-			list_size -= 1;
-		}
-		if ( cont == aux ) {
-			current_node = current_node->next_node;
 		}
 		else {
-			aux = cont;
+			current_node = current_node->next_node;
 		}
 	}
 	return cont;
 }
 
+/* Mutator: erase( Double_node *node )
+	This mutator deletes the node (which must be a non-sentinel node of this list) in O(1),
+	without searching the list.
+	It returns the address of the node that followed the deleted node
+*/
+
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::erase( Double_node *node ) {
+
+	Double_node *next = node->next_node;
+	unlink_chain( node, node );
+	destroy_node( node );
+	list_size -= 1;
+	return next;
+}
+
+/* Mutator: splice( position, list )
+	This mutator moves all the nodes of the argument list in front of position in O(1).
+	No node is allocated or copied, and the argument list is left empty.
+	Throws illegal_argument if the allocators of both lists are not equal, since
+	*this list will release the moved nodes
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::splice( Double_node *position, Double_sentinel_list<Type, Alloc> &list ) {
+
+	if ( &list == this or list.empty() ) return;
+	if ( list_allocator != list.list_allocator ) throw illegal_argument();
+
+	Double_node *first = list.list_head->next_node;
+	Double_node *last = list.list_tail->previous_node;
+	unlink_chain( first, last );
+	link_chain( position, first, last );
+	list_size += list.list_size;
+	list.list_size = 0;
+}
+
+/* Mutator: splice( position, list, node )
+	This mutator moves one node of the argument list in front of position in O(1).
+	Throws illegal_argument if the allocators of both lists are not equal
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::splice( Double_node *position, Double_sentinel_list<Type, Alloc> &list, Double_node *node ) {
+
+	if ( node == position or node->next_node == position ) return;
+	if ( list_allocator != list.list_allocator ) throw illegal_argument();
+
+	unlink_chain( node, node );
+	link_chain( position, node, node );
+	list.list_size -= 1;
+	list_size += 1;
+}
+
+/* Mutator: splice( position, list, first, last )
+	This mutator moves the nodes [first, last) of the argument list in front of position.
+	position must not be one of the moved nodes.
+	The links are updated in O(1); moving between two different lists also counts the
+	moved nodes to keep both sizes right.
+	Throws illegal_argument if the allocators of both lists are not equal
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::splice( Double_node *position, Double_sentinel_list<Type, Alloc> &list, Double_node *first, Double_node *last ) {
+
+	if ( first == last or last == position ) return;
+	if ( list_allocator != list.list_allocator ) throw illegal_argument();
+
+	if ( &list != this ) {
+		int moved = 0;
+		for ( Double_node *node = first; node != last; node = node->next_node ) {
+			moved += 1;
+		}
+		list.list_size -= moved;
+		list_size += moved;
+	}
+
+	Double_node *back = last->previous_node;
+	unlink_chain( first, back );
+	link_chain( position, first, back );
+}
+
+/* Mutator: insert_range( position, first, last )
+	This mutator inserts copies of the values in [first, last) in front of position.
+	The new nodes are built as a separate chain and linked into the list in one step,
+	so if a copy throws the list is left unchanged.
+	It returns the address of the first inserted node, or position if the range is empty
+*/
+
+template <typename Type, typename Alloc>
+template <typename Iterator>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::insert_range( Double_node *position, Iterator first, Iterator last ) {
+
+	if ( first == last ) return position;
+
+	Double_node *chain_front = create_node( nullptr, nullptr, *first );
+	Double_node *chain_back = chain_front;
+	int inserted = 1;
+
+	try {
+		for ( ++first; first != last; ++first ) {
+			chain_back->next_node = create_node( chain_back, nullptr, *first );
+			chain_back = chain_back->next_node;
+			inserted += 1;
+		}
+	}
+	catch ( ... ) {
+		while ( chain_front != nullptr ) {
+			Double_node *temp_node = chain_front;
+			chain_front = chain_front->next_node;
+			destroy_node( temp_node );
+		}
+		throw;
+	}
+
+	link_chain( position, chain_front, chain_back );
+	list_size += inserted;
+	return chain_front;
+}
+
+/* Mutator: append( Double_sentinel_list &&list )
+	This mutator moves all the nodes of the argument list to the back of *this list in O(1)
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::append( Double_sentinel_list<Type, Alloc> &&list ) {
+
+	splice( list_tail, list );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+/* Private member function: create_node( previous, next, args... )
+	This function obtains the memory for a new node from the allocator policy and
+	constructs the node in place, with its value constructed from args.
+	If the constructor of Type throws, the memory is given back to the allocator.
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Args>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::create_node(
+	Double_node *previous,
+	Double_node *next,
+	Args &&... args ) {
+
+	void *memory = list_allocator.allocate( sizeof( Double_node ) );
+
+	try {
+		return new ( memory ) Double_node( previous, next, std::forward<Args>( args )... );
+	}
+	catch ( ... ) {
+		list_allocator.deallocate( memory, sizeof( Double_node ) );
+		throw;
+	}
+}
+
+/* Private member function: insert_node( position, args... )
+	This function creates a node with its value constructed from args and links it
+	in front of position. It returns the address of the new node.
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Args>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::insert_node( Double_node *position, Args &&... args ) {
+
+	Double_node *aux = create_node( position->previous_node, position, std::forward<Args>( args )... );
+	position->previous_node->next_node = aux;
+	position->previous_node = aux;
+	list_size += 1;
+	return aux;
+}
+
+/* Private member function: destroy_node( Double_node *node )
+	This function destroys the node and gives its memory back to the allocator policy.
+	Passing nullptr does nothing.
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::destroy_node( Double_node *node ) {
+
+	if ( node == nullptr ) return;
+
+	node->~Double_node();
+	list_allocator.deallocate( node, sizeof( Double_node ) );
+}
+
 /* Node Constructor: Double_node( nv, pn, nn )
 	This is the default constructor for the nodes in the list 
 	nv -> Member variable that stores the value of the node
@@ -406,32 +845,55 @@ int Double_sentinel_list<Type>::erase( Type const &obj ) {
 	No errors are expected with this constructor
 */
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_node::Double_node(
+template <typename Type, typename Alloc>
+Double_sentinel_list<Type, Alloc>::Double_node::Double_node(
 	Type const &nv,
-	typename Double_sentinel_list<Type>::Double_node *pn,
-	typename Double_sentinel_list<Type>::Double_node *nn ):
+	typename Double_sentinel_list<Type, Alloc>::Double_node *pn,
+	typename Double_sentinel_list<Type, Alloc>::Double_node *nn ):
 node_value( nv ), 
 previous_node( pn ),
 next_node( nn )
 { }
 
+/* Node Constructor: Double_node( pn, nn, args... )
+	This constructor builds the value of the node in place from args
+	pn -> Pointer to the previous Double_node
+	nn -> Pointer to the next Double_node
+*/
+
+template <typename Type, typename Alloc>
+template <typename... Args>
+Double_sentinel_list<Type, Alloc>::Double_node::Double_node(
+	typename Double_sentinel_list<Type, Alloc>::Double_node *pn,
+	typename Double_sentinel_list<Type, Alloc>::Double_node *nn,
+	Args &&... args ):
+node_value( std::forward<Args>( args )... ),
+previous_node( pn ),
+next_node( nn )
+{ }
+
 /* Member function: value()
-	This member function returns the value of the node
+	This member function returns a reference to the value of the node
 */
 
-template <typename Type>
-Type Double_sentinel_list<Type>::Double_node::value() const {
-	
-	return node_value; 
+template <typename Type, typename Alloc>
+Type &Double_sentinel_list<Type, Alloc>::Double_node::value() {
+
+	return node_value;
+}
+
+template <typename Type, typename Alloc>
+Type const &Double_sentinel_list<Type, Alloc>::Double_node::value() const {
+
+	return node_value;
 }
 
 /* Member function: previous()
 	This member function returns the previous pointer
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::Double_node::previous() const {
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::Double_node::previous() const {
 	
 	return previous_node;
 }
@@ -440,8 +902,328 @@ typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::Do
 	This member function returns the next pointer
 */
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::Double_node::next() const {
+template <typename Type, typename Alloc>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::Double_node::next() const {
 	
 	return next_node;
 }
+
+/* Private member function: traverse( visit )
+	This function calls visit( node ) on each node from the front of the list, and stops at
+	the first node for which visit returns true. It returns that node, or end().
+	A second pointer runs PREFETCH_DISTANCE nodes ahead of the visited node and prefetches
+	the node after the one it reaches, so the visited nodes are already in the cache and the
+	work of visit() overlaps the pointer chase. The chase is still a chain of dependent
+	loads: each step needs the address read by the previous one, so at most one node miss
+	is in flight at a time, whatever PREFETCH_DISTANCE is. The gain is bounded by the time
+	spent in visit(), not by the memory latency of PREFETCH_DISTANCE nodes.
+*/
+
+template <typename Type, typename Alloc>
+template <typename Visitor>
+typename Double_sentinel_list<Type, Alloc>::Double_node *Double_sentinel_list<Type, Alloc>::traverse( Visitor visit ) const {
+
+	Double_node *ahead = list_head->next_node;
+
+	for ( int i = 0; i < PREFETCH_DISTANCE and ahead != list_tail; ++i ) {
+		ahead = ahead->next_node;
+		prefetch( ahead );
+	}
+
+	for ( Double_node *node = list_head->next_node; node != list_tail; node = node->next_node ) {
+		if ( ahead != list_tail ) {
+			ahead = ahead->next_node;
+			prefetch( ahead );
+		}
+
+		if ( visit( node ) ) return node;
+	}
+
+	return list_tail;
+}
+
+/* Private member function: prefetch( node )
+	This function hints the processor to load the node into the cache
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::prefetch( Double_node const *node ) {
+
+#if defined( __GNUC__ )
+	__builtin_prefetch( node );
+#else
+	(void) node;
+#endif
+}
+
+/* Private member function: unlink_chain( first, last )
+	This function removes the chain of nodes first, ..., last from the list they are in.
+	The links inside the chain are not modified.
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::unlink_chain( Double_node *first, Double_node *last ) {
+
+	first->previous_node->next_node = last->next_node;
+	last->next_node->previous_node = first->previous_node;
+}
+
+/* Private member function: link_chain( position, first, last )
+	This function links the chain of nodes first, ..., last in front of position
+*/
+
+template <typename Type, typename Alloc>
+void Double_sentinel_list<Type, Alloc>::link_chain( Double_node *position, Double_node *first, Double_node *last ) {
+
+	first->previous_node = position->previous_node;
+	last->next_node = position;
+	position->previous_node->next_node = first;
+	position->previous_node = last;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                          Node allocators                            //
+/////////////////////////////////////////////////////////////////////////
+
+/* Member function: New_node_allocator::allocate( bytes )
+	This member function returns a block of bytes obtained with the global operator new
+*/
+
+inline void *New_node_allocator::allocate( std::size_t bytes ) {
+
+	return ::operator new( bytes );
+}
+
+/* Member function: New_node_allocator::deallocate( address, bytes )
+	This member function releases the block with the global operator delete
+*/
+
+inline void New_node_allocator::deallocate( void *address, std::size_t ) {
+
+	::operator delete( address );
+}
+
+/* Member function: New_node_allocator::reserve( bytes, n )
+	Every node must be releasable on its own with operator delete, so nothing can be
+	requested in advance and this hint is ignored
+*/
+
+inline void New_node_allocator::reserve( std::size_t, int ) {
+}
+
+/* Member function: New_node_allocator::operator==
+	Any New_node_allocator can release the nodes of another one
+*/
+
+inline bool New_node_allocator::operator==( New_node_allocator const & ) const {
+
+	return true;
+}
+
+inline bool New_node_allocator::operator!=( New_node_allocator const &rhs ) const {
+
+	return !( *this == rhs );
+}
+
+/* Constructor: Node_pool( n )
+	This constructor creates an empty pool. No memory is requested until the first
+	allocation, and then it is requested in slabs of n blocks (at least 1).
+	No errors are expected with this constructor
+*/
+
+inline Node_pool::Node_pool( int n ):
+block_size( 0 ),
+slab_blocks( ( n < 1 ) ? 1 : n ),
+pool_capacity( 0 ),
+pool_available( 0 ),
+slab_list( nullptr ),
+free_list( nullptr )
+{ }
+
+/* Destructor: ~Node_pool()
+	It returns every slab to the system. All the lists using the pool must have
+	been destroyed before the pool is destroyed.
+*/
+
+inline Node_pool::~Node_pool() {
+
+	while ( slab_list != nullptr ) {
+		Slab *temp_slab = slab_list;
+		slab_list = slab_list->next_slab;
+		::operator delete( temp_slab );
+	}
+}
+
+/* Accessor: capacity()
+	This function returns the number of blocks owned by the pool
+*/
+
+inline int Node_pool::capacity() const {
+	return pool_capacity;
+}
+
+/* Accessor: available()
+	This function returns the number of blocks waiting on the free list
+*/
+
+inline int Node_pool::available() const {
+	return pool_available;
+}
+
+/* Mutator: allocate( bytes )
+	This mutator pops the most recently released block from the free list. If the
+	free list is empty a new slab is requested first.
+	The first call fixes the block size of the pool; other sizes go to operator new.
+*/
+
+inline void *Node_pool::allocate( std::size_t bytes ) {
+
+	std::size_t size = round_up( bytes );
+
+	if ( block_size == 0 ) block_size = size;
+	if ( size != block_size ) return ::operator new( bytes );
+
+	if ( free_list == nullptr ) grow( slab_blocks );
+
+	Free_block *block = free_list;
+	free_list = block->next_block;
+	pool_available -= 1;
+	return block;
+}
+
+/* Mutator: deallocate( address, bytes )
+	This mutator pushes the block on the front of the free list, so it is the
+	first one handed out by the next allocation
+*/
+
+inline void Node_pool::deallocate( void *address, std::size_t bytes ) {
+
+	if ( round_up( bytes ) != block_size ) {
+		::operator delete( address );
+		return;
+	}
+
+	Free_block *block = static_cast<Free_block *>( address );
+	block->next_block = free_list;
+	free_list = block;
+	pool_available += 1;
+}
+
+/* Mutator: reserve( bytes, n )
+	This mutator makes sure that at least n blocks are waiting on the free list. The
+	missing blocks are requested as one slab (of at least slab_blocks blocks), so a
+	burst of n allocations costs at most one request to the system.
+*/
+
+inline void Node_pool::reserve( std::size_t bytes, int n ) {
+
+	std::size_t size = round_up( bytes );
+
+	if ( block_size == 0 ) block_size = size;
+	if ( size != block_size or n <= pool_available ) return;
+
+	grow( std::max( n - pool_available, slab_blocks ) );
+}
+
+/* Private member function: round_up( bytes )
+	This function rounds bytes up to a multiple of the fundamental alignment,
+	and to at least the size of a free list link
+*/
+
+inline std::size_t Node_pool::round_up( std::size_t bytes ) {
+
+	std::size_t const align = alignof( std::max_align_t );
+
+	if ( bytes < sizeof( Free_block ) ) bytes = sizeof( Free_block );
+	return ( bytes + align - 1 ) / align * align;
+}
+
+/* Private member function: grow( n )
+	This function requests a new slab of n blocks from the system and threads all its
+	blocks on the free list. The slab header is padded so the blocks stay aligned.
+*/
+
+inline void Node_pool::grow( int n ) {
+
+	std::size_t header = round_up( sizeof( Slab ) );
+	char *memory = static_cast<char *>( ::operator new( header + block_size*n ) );
+
+	Slab *slab = reinterpret_cast<Slab *>( memory );
+	slab->next_slab = slab_list;
+	slab_list = slab;
+
+	// Thread the blocks backwards so they are handed out in address order
+	for ( int i = n - 1; i >= 0; --i ) {
+		Free_block *block = reinterpret_cast<Free_block *>( memory + header + block_size*i );
+		block->next_block = free_list;
+		free_list = block;
+	}
+
+	pool_capacity += n;
+	pool_available += n;
+}
+
+/* Constructor: Pool_node_allocator( n )
+	This constructor creates an allocator with its own pool, growing in slabs of n nodes
+*/
+
+inline Pool_node_allocator::Pool_node_allocator( int n ):
+node_pool( std::make_shared<Node_pool>( n ) )
+{ }
+
+/* Constructor: Pool_node_allocator( pool )
+	This constructor creates an allocator that takes its nodes from an existing pool
+*/
+
+inline Pool_node_allocator::Pool_node_allocator( std::shared_ptr<Node_pool> const &pool ):
+node_pool( pool )
+{ }
+
+/* Accessor: pool()
+	This function returns the pool shared by this allocator
+*/
+
+inline std::shared_ptr<Node_pool> Pool_node_allocator::pool() const {
+	return node_pool;
+}
+
+/* Member function: Pool_node_allocator::allocate( bytes )
+	This member function takes a block from the shared pool
+*/
+
+inline void *Pool_node_allocator::allocate( std::size_t bytes ) {
+
+	return node_pool->allocate( bytes );
+}
+
+/* Member function: Pool_node_allocator::deallocate( address, bytes )
+	This member function gives a block back to the shared pool
+*/
+
+inline void Pool_node_allocator::deallocate( void *address, std::size_t bytes ) {
+
+	node_pool->deallocate( address, bytes );
+}
+
+/* Member function: Pool_node_allocator::reserve( bytes, n )
+	This member function asks the shared pool to have n blocks ready
+*/
+
+inline void Pool_node_allocator::reserve( std::size_t bytes, int n ) {
+
+	node_pool->reserve( bytes, n );
+}
+
+/* Member function: Pool_node_allocator::operator==
+	Two pool allocators are equal if they share the same pool
+*/
+
+inline bool Pool_node_allocator::operator==( Pool_node_allocator const &rhs ) const {
+
+	return ( node_pool == rhs.node_pool );
+}
+
+inline bool Pool_node_allocator::operator!=( Pool_node_allocator const &rhs ) const {
+
+	return !( *this == rhs );
+}
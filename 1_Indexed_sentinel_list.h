@@ -0,0 +1,851 @@
+#include <iostream>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/* Indexed_sentinel_list<Type>
+	A doubly linked list with head and tail sentinels and the same interface as
+	Double_sentinel_list, whose nodes all live in one array of slots. The links are 32-bit
+	indices into that array instead of pointers, so a node of a list of ints takes
+	12 bytes instead of 24, scans walk a single block of memory, and the whole list can
+	be copied or written out as one array.
+	The head sentinel is slot 0 and the tail sentinel is slot 1. A value is constructed in
+	its slot when its node is inserted and destroyed when the node is erased, so Type needs
+	no default constructor and erased slots hold no objects. Erased slots are kept on a
+	free list (threaded through their next links) and reused by the next insertion.
+	When the array is full the values are moved to an array twice as large.
+
+	The nodes are returned as Indexed_node handles (slot array and index) rather than
+	addresses, since the array moves when it grows. A handle supports value(), previous(),
+	next(), == and !=, and also -> so loops written for Double_sentinel_list, such as
+		for ( auto node = list.begin(); node != list.end(); node = node->next() )
+	compile unchanged. The array is reached through a separately allocated Slot_array that
+	goes with the nodes when lists are swapped or moved, so, as with Double_sentinel_list,
+	a handle stays valid until its node is erased (after a swap or a move it is a handle
+	of the list that now holds the node).
+*/
+
+template <typename Type>
+class Indexed_sentinel_list {
+	class Slot;
+	class Slot_array;
+
+	public:
+		class Indexed_node {
+			public:
+				Indexed_node( Slot_array * = nullptr, std::uint32_t = 0 );
+
+				Type &value() const;
+				Indexed_node previous() const;
+				Indexed_node next() const;
+				std::uint32_t index() const;
+
+				Indexed_node const *operator->() const;
+				bool operator==( Indexed_node const & ) const;
+				bool operator!=( Indexed_node const & ) const;
+
+			private:
+				Slot_array *node_slots;
+				std::uint32_t node_index;
+		};
+
+		// Constructors
+
+		Indexed_sentinel_list();
+		Indexed_sentinel_list( Indexed_sentinel_list const & );
+		Indexed_sentinel_list( Indexed_sentinel_list && );
+		~Indexed_sentinel_list();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		Type &front();
+		Type const &front() const;
+		Type &back();
+		Type const &back() const;
+
+		Indexed_node begin() const;
+		Indexed_node end() const;
+		Indexed_node rbegin() const;
+		Indexed_node rend() const;
+
+		Indexed_node find( Type const & ) const;
+		int count( Type const & ) const;
+
+		// Mutators
+
+		void swap( Indexed_sentinel_list & );
+		Indexed_sentinel_list &operator=( Indexed_sentinel_list const & );
+		Indexed_sentinel_list &operator=( Indexed_sentinel_list && );
+
+		void reserve( int );
+
+		void push_front( Type const & );
+		void push_front( Type && );
+		void push_back( Type const & );
+		void push_back( Type && );
+
+		template <typename... Args>
+		Type &emplace_front( Args &&... );
+		template <typename... Args>
+		Type &emplace_back( Args &&... );
+		template <typename... Args>
+		Indexed_node emplace( Indexed_node, Args &&... );
+
+		void pop_front();
+		void pop_back();
+
+		int erase( Type const & );
+		Indexed_node erase( Indexed_node );
+
+		template <typename Iterator>
+		Indexed_node insert_range( Indexed_node, Iterator, Iterator );
+		void append( Indexed_sentinel_list && );
+
+	private:
+		class Slot {
+			public:
+				Type *value();
+
+				alignas( Type ) unsigned char value_storage[sizeof( Type )];
+				std::uint32_t previous_node;
+				std::uint32_t next_node;
+		};
+
+		// The slots and their count; only the values of linked nodes are constructed
+		class Slot_array {
+			public:
+				Slot_array( std::uint32_t );
+				Slot_array( Slot_array const & ) = delete;
+				Slot_array &operator=( Slot_array const & ) = delete;
+				~Slot_array();
+
+				Slot *slots;
+				std::uint32_t slot_count;
+				std::uint32_t slot_capacity;
+		};
+
+		static std::uint32_t const HEAD = 0;
+		static std::uint32_t const TAIL = 1;
+		static std::uint32_t const NONE = 0xffffffff;
+
+		Slot_array *list_storage;
+		std::uint32_t free_slot;
+		int list_size;
+
+		Slot &slot( std::uint32_t ) const;
+		template <typename... Args>
+		std::uint32_t insert_node( std::uint32_t, Args &&... );
+		void unlink_node( std::uint32_t );
+		void relocate( Slot * );
+		void destroy_values();
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                      Public member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+/* Default Constructor: Indexed_sentinel_list()
+	This is the default constructor that creates the head (slot 0) and tail (slot 1)
+	sentinel nodes linked to each other
+	No errors are expected with this constructor
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::Indexed_sentinel_list():
+list_storage( new Slot_array( 2 ) ),
+free_slot( NONE ),
+list_size( 0 )
+{
+	list_storage->slot_count = 2;
+	slot( HEAD ).previous_node = NONE;
+	slot( HEAD ).next_node = TAIL;
+	slot( TAIL ).previous_node = HEAD;
+	slot( TAIL ).next_node = NONE;
+}
+
+/* Copy Constructor: Indexed_sentinel_list( list )
+	This constructor copies the slot array in one allocation: the links are copied as they
+	are and the values are copy constructed in the same slots. The indices stay valid,
+	so the copy has the same links (and the same free slots) as the argument list.
+	If copying a value throws, the values already copied are destroyed and the delegated
+	constructor has completed, so the destructor releases the empty list.
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::Indexed_sentinel_list( Indexed_sentinel_list<Type> const &list ):
+Indexed_sentinel_list()
+{
+	Slot_array copy( list.list_storage->slot_count );
+	std::uint32_t current = list.slot( HEAD ).next_node;
+
+	try {
+		for ( ; current != TAIL; current = list.slot( current ).next_node ) {
+			new ( copy.slots[current].value() ) Type( *list.slot( current ).value() );
+		}
+	}
+	catch ( ... ) {
+		for ( std::uint32_t node = list.slot( HEAD ).next_node; node != current; node = list.slot( node ).next_node ) {
+			copy.slots[node].value()->~Type();
+		}
+		throw;
+	}
+
+	for ( std::uint32_t i = 0; i < list.list_storage->slot_count; ++i ) {
+		copy.slots[i].previous_node = list.slot( i ).previous_node;
+		copy.slots[i].next_node = list.slot( i ).next_node;
+	}
+
+	std::swap( list_storage->slots, copy.slots );
+	list_storage->slot_count = list_storage->slot_capacity = list.list_storage->slot_count;
+	free_slot = list.free_slot;
+	list_size = list.list_size;
+}
+
+/* Move Constructor: Indexed_sentinel_list( list )
+	This constructor takes the slots of the argument list in O(1). The argument is left as
+	a valid empty list with its own slot array, so it can still be used or assigned to.
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::Indexed_sentinel_list( Indexed_sentinel_list<Type> &&list ):
+Indexed_sentinel_list()
+{
+	this->swap( list );
+}
+
+/* Destructor: ~Indexed_sentinel_list()
+	It destroys the values of the nodes; the slot array is then released at once
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::~Indexed_sentinel_list() {
+
+	destroy_values();
+	delete list_storage;
+}
+
+/* Accessor: size()
+	This function returns the size of the list
+*/
+
+template <typename Type>
+int Indexed_sentinel_list<Type>::size() const {
+	return list_size;
+}
+
+/* Accessor: empty()
+	This function returns true if the list is empty, or false otherwise.
+*/
+
+template <typename Type>
+bool Indexed_sentinel_list<Type>::empty() const {
+	return ( list_size == 0 );
+}
+
+/* Accessor: capacity()
+	This function returns the number of nodes that fit in the slot vector without
+	reallocating, not counting the sentinels
+*/
+
+template <typename Type>
+int Indexed_sentinel_list<Type>::capacity() const {
+	return int( list_storage->slot_capacity ) - 2;
+}
+
+/* Accessor: front()
+	This function returns a reference to the object stored in the first node
+	Throws underflow if the list is empty
+*/
+
+template <typename Type>
+Type &Indexed_sentinel_list<Type>::front() {
+	if ( empty() ) throw underflow();
+
+	return *slot( slot( HEAD ).next_node ).value();
+}
+
+template <typename Type>
+Type const &Indexed_sentinel_list<Type>::front() const {
+	if ( empty() ) throw underflow();
+
+	return *slot( slot( HEAD ).next_node ).value();
+}
+
+/* Accessor: back()
+	This function returns a reference to the object stored in the last node
+	Throws underflow if the list is empty
+*/
+
+template <typename Type>
+Type &Indexed_sentinel_list<Type>::back() {
+	if ( empty() ) throw underflow();
+
+	return *slot( slot( TAIL ).previous_node ).value();
+}
+
+template <typename Type>
+Type const &Indexed_sentinel_list<Type>::back() const {
+	if ( empty() ) throw underflow();
+
+	return *slot( slot( TAIL ).previous_node ).value();
+}
+
+/* Accessor: begin()
+	This function returns the handle of the first node in the list
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::begin() const {
+	return Indexed_node( list_storage, slot( HEAD ).next_node );
+}
+
+/* Accessor: end()
+	This function returns the handle of the tail sentinel
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::end() const {
+	return Indexed_node( list_storage, TAIL );
+}
+
+/* Accessor: rbegin()
+	This function returns the handle of the last node in the list
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::rbegin() const {
+	return Indexed_node( list_storage, slot( TAIL ).previous_node );
+}
+
+/* Accessor: rend()
+	This function returns the handle of the head sentinel
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::rend() const {
+	return Indexed_node( list_storage, HEAD );
+}
+
+/* Accessor: find()
+	This function returns the handle of the first node storing a value equal to the argument
+	It returns end() if none is found.
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::find( Type const &obj ) const {
+
+	std::uint32_t current = slot( HEAD ).next_node;
+
+	while ( current != TAIL and !( *slot( current ).value() == obj ) ) {
+		current = slot( current ).next_node;
+	}
+
+	return Indexed_node( list_storage, current );
+}
+
+/* Accessor: count()
+	This function returns the number of nodes storing a value equal to the argument
+*/
+
+template <typename Type>
+int Indexed_sentinel_list<Type>::count( Type const &obj ) const {
+
+	int cont = 0;
+
+	for ( std::uint32_t current = slot( HEAD ).next_node; current != TAIL; current = slot( current ).next_node ) {
+		cont += ( *slot( current ).value() == obj );
+	}
+
+	return cont;
+}
+
+/* Mutator: swap( Indexed_sentinel_list<Type> &list )
+	This mutator swaps all the member variables of *this list with those of the argument list.
+	The slot arrays are exchanged, so the node handles go with their nodes.
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::swap( Indexed_sentinel_list<Type> &list ) {
+
+	std::swap( list_storage, list.list_storage );
+	std::swap( free_slot, list.free_slot );
+	std::swap( list_size, list.list_size );
+}
+
+/* Mutator: Assignment operator
+	This assignment operator copies the argument list into the *this list
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type> &Indexed_sentinel_list<Type>::operator=( Indexed_sentinel_list<Type> const &rhs ) {
+
+	Indexed_sentinel_list<Type> copy( rhs );
+	swap( copy );
+
+	return *this;
+}
+
+/* Mutator: Move operator
+	This assignment operator moves the slots of the argument list into *this list
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type> &Indexed_sentinel_list<Type>::operator=( Indexed_sentinel_list<Type> &&rhs ) {
+
+	swap( rhs );
+
+	return *this;
+}
+
+/* Mutator: reserve( n )
+	This mutator makes room for n nodes, so the next insertions do not reallocate
+	Throws overflow if n nodes do not fit in 32-bit indices
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::reserve( int n ) {
+
+	if ( std::uint64_t( n ) + 2 > NONE ) throw overflow();
+	if ( n + 2 <= int( list_storage->slot_capacity ) ) return;
+
+	Slot_array larger( std::uint32_t( n ) + 2 );
+	relocate( larger.slots );
+	std::swap( list_storage->slots, larger.slots );
+	list_storage->slot_capacity = std::uint32_t( n ) + 2;
+}
+
+/* Mutator: push_front( obj )
+	This mutator inserts a node, storing a copy of obj (or moving obj), at the front of the list.
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::push_front( Type const &obj ) {
+
+	insert_node( slot( HEAD ).next_node, obj );
+}
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::push_front( Type &&obj ) {
+
+	insert_node( slot( HEAD ).next_node, std::move( obj ) );
+}
+
+/* Mutator: push_back( obj )
+	This mutator inserts a node, storing a copy of obj (or moving obj), at the back of the list.
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::push_back( Type const &obj ) {
+
+	insert_node( TAIL, obj );
+}
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::push_back( Type &&obj ) {
+
+	insert_node( TAIL, std::move( obj ) );
+}
+
+/* Mutator: emplace_front( args... )
+	This mutator inserts a node at the front of the list with its value built from args.
+	It returns a reference to the new value.
+*/
+
+template <typename Type>
+template <typename... Args>
+Type &Indexed_sentinel_list<Type>::emplace_front( Args &&... args ) {
+
+	return *slot( insert_node( slot( HEAD ).next_node, std::forward<Args>( args )... ) ).value();
+}
+
+/* Mutator: emplace_back( args... )
+	This mutator inserts a node at the back of the list with its value built from args.
+	It returns a reference to the new value.
+*/
+
+template <typename Type>
+template <typename... Args>
+Type &Indexed_sentinel_list<Type>::emplace_back( Args &&... args ) {
+
+	return *slot( insert_node( TAIL, std::forward<Args>( args )... ) ).value();
+}
+
+/* Mutator: emplace( position, args... )
+	This mutator inserts a node in front of position with its value built from args.
+	It returns the handle of the new node.
+*/
+
+template <typename Type>
+template <typename... Args>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::emplace( Indexed_node position, Args &&... args ) {
+
+	return Indexed_node( list_storage, insert_node( position.index(), std::forward<Args>( args )... ) );
+}
+
+/* Mutator: pop_front()
+	This mutator removes the first (non-sentinel) node on the list
+	Throws underflow() if the list is empty
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::pop_front() {
+
+	if ( empty() ) throw underflow();
+
+	unlink_node( slot( HEAD ).next_node );
+}
+
+/* Mutator: pop_back()
+	This mutator removes the last (non-sentinel) node on the list
+	Throws underflow() if the list is empty
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::pop_back() {
+
+	if ( empty() ) throw underflow();
+
+	unlink_node( slot( TAIL ).previous_node );
+}
+
+/* Mutator: erase( Type const &obj )
+	This mutator deletes all the nodes that have a value equal to the argument obj.
+	It returns the number of deleted nodes
+*/
+
+template <typename Type>
+int Indexed_sentinel_list<Type>::erase( Type const &obj ) {
+
+	int cont = 0;
+	std::uint32_t current = slot( HEAD ).next_node;
+
+	while ( current != TAIL ) {
+		std::uint32_t next = slot( current ).next_node;
+		if ( *slot( current ).value() == obj ) {
+			unlink_node( current );
+			cont += 1;
+		}
+		current = next;
+	}
+
+	return cont;
+}
+
+/* Mutator: erase( Indexed_node node )
+	This mutator deletes the node (a non-sentinel node of this list) in O(1).
+	It returns the handle of the node that followed it
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::erase( Indexed_node node ) {
+
+	std::uint32_t next = slot( node.index() ).next_node;
+	unlink_node( node.index() );
+	return Indexed_node( list_storage, next );
+}
+
+/* Mutator: insert_range( position, first, last )
+	This mutator inserts copies of the values in [first, last) in front of position.
+	If a copy throws, the nodes already inserted are unlinked again, so the list is left unchanged.
+	It returns the handle of the first inserted node, or position if the range is empty
+*/
+
+template <typename Type>
+template <typename Iterator>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::insert_range( Indexed_node position, Iterator first, Iterator last ) {
+
+	if ( first == last ) return position;
+
+	std::uint32_t front_index = insert_node( position.index(), *first );
+
+	try {
+		for ( ++first; first != last; ++first ) {
+			insert_node( position.index(), *first );
+		}
+	}
+	catch ( ... ) {
+		while ( front_index != position.index() ) {
+			std::uint32_t next = slot( front_index ).next_node;
+			unlink_node( front_index );
+			front_index = next;
+		}
+		throw;
+	}
+
+	return Indexed_node( list_storage, front_index );
+}
+
+/* Mutator: append( Indexed_sentinel_list &&list )
+	This mutator moves the values of the argument list to the back of *this list, in order,
+	after reserving room for all of them. The argument list is left empty, and the handles
+	of its nodes are no longer valid, as the values are moved to new slots.
+	If *this list is empty the slot arrays are simply exchanged.
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::append( Indexed_sentinel_list<Type> &&list ) {
+
+	if ( &list == this ) return;
+
+	if ( empty() ) {
+		swap( list );
+		return;
+	}
+
+	reserve( list_size + list.list_size );
+
+	for ( std::uint32_t current = list.slot( HEAD ).next_node; current != TAIL; current = list.slot( current ).next_node ) {
+		insert_node( TAIL, std::move( *list.slot( current ).value() ) );
+	}
+
+	Indexed_sentinel_list<Type> empty_list;
+	list.swap( empty_list );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+/* Private member function: slot( index )
+	This function returns the slot index of the slot array
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Slot &Indexed_sentinel_list<Type>::slot( std::uint32_t index ) const {
+
+	return list_storage->slots[index];
+}
+
+/* Private member function: insert_node( position, args... )
+	This function takes a slot from the free list (or the next unused slot), constructs
+	its value from args in place and links it in front of the slot position.
+	It returns the index of the new node.
+	If the array is full, the value is constructed in an array twice as large before the
+	other values are moved there, since args may refer to a value of this list.
+	If constructing the value throws, the list is left unchanged.
+	Throws overflow if the list already has 2^32 - 2 slots
+*/
+
+template <typename Type>
+template <typename... Args>
+std::uint32_t Indexed_sentinel_list<Type>::insert_node( std::uint32_t position, Args &&... args ) {
+
+	Slot_array &storage = *list_storage;
+	std::uint32_t index;
+
+	if ( free_slot != NONE ) {
+		index = free_slot;
+		new ( storage.slots[index].value() ) Type( std::forward<Args>( args )... );
+		free_slot = storage.slots[index].next_node;
+	}
+	else if ( storage.slot_count < storage.slot_capacity ) {
+		index = storage.slot_count;
+		new ( storage.slots[index].value() ) Type( std::forward<Args>( args )... );
+		storage.slot_count += 1;
+	}
+	else {
+		if ( storage.slot_count >= NONE ) throw overflow();
+
+		std::uint32_t capacity = ( storage.slot_capacity > NONE/2 ) ? NONE : 2*storage.slot_capacity;
+		Slot_array larger( capacity );
+		index = storage.slot_count;
+		new ( larger.slots[index].value() ) Type( std::forward<Args>( args )... );
+
+		try {
+			relocate( larger.slots );
+		}
+		catch ( ... ) {
+			larger.slots[index].value()->~Type();
+			throw;
+		}
+
+		std::swap( storage.slots, larger.slots );
+		storage.slot_capacity = capacity;
+		storage.slot_count += 1;
+	}
+
+	Slot &new_slot = storage.slots[index];
+	new_slot.previous_node = storage.slots[position].previous_node;
+	new_slot.next_node = position;
+	storage.slots[new_slot.previous_node].next_node = index;
+	storage.slots[position].previous_node = index;
+	list_size += 1;
+
+	return index;
+}
+
+/* Private member function: unlink_node( index )
+	This function unlinks a (non-sentinel) node, destroys its value, and pushes the slot
+	on the free list
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::unlink_node( std::uint32_t index ) {
+
+	Slot &erased = slot( index );
+	slot( erased.previous_node ).next_node = erased.next_node;
+	slot( erased.next_node ).previous_node = erased.previous_node;
+
+	erased.value()->~Type();
+	erased.previous_node = NONE;
+	erased.next_node = free_slot;
+	free_slot = index;
+	list_size -= 1;
+}
+
+/* Private member function: relocate( destination )
+	This function moves the values of the nodes to the same slots of the array destination
+	(which has room for all the used slots), copies all the links, and destroys the values
+	left in the old array. The caller then installs destination as the slot array.
+	A value is moved only if its move constructor does not throw, and copied otherwise;
+	if a copy throws, the values already built in destination are destroyed, so the list
+	is left unchanged.
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::relocate( Slot *destination ) {
+
+	std::uint32_t current = slot( HEAD ).next_node;
+
+	try {
+		for ( ; current != TAIL; current = slot( current ).next_node ) {
+			new ( destination[current].value() ) Type( std::move_if_noexcept( *slot( current ).value() ) );
+		}
+	}
+	catch ( ... ) {
+		for ( std::uint32_t node = slot( HEAD ).next_node; node != current; node = slot( node ).next_node ) {
+			destination[node].value()->~Type();
+		}
+		throw;
+	}
+
+	for ( std::uint32_t i = 0; i < list_storage->slot_count; ++i ) {
+		destination[i].previous_node = slot( i ).previous_node;
+		destination[i].next_node = slot( i ).next_node;
+	}
+
+	destroy_values();
+}
+
+/* Private member function: destroy_values()
+	This function destroys the values of all the nodes, leaving the links unchanged
+*/
+
+template <typename Type>
+void Indexed_sentinel_list<Type>::destroy_values() {
+
+	for ( std::uint32_t current = slot( HEAD ).next_node; current != TAIL; current = slot( current ).next_node ) {
+		slot( current ).value()->~Type();
+	}
+}
+
+/* Slot function: value()
+	This function returns the address of the value constructed in the slot
+*/
+
+template <typename Type>
+Type *Indexed_sentinel_list<Type>::Slot::value() {
+
+	return std::launder( reinterpret_cast<Type *>( value_storage ) );
+}
+
+/* Slot_array Constructor: Slot_array( capacity )
+	This constructor allocates capacity slots, none of them used
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::Slot_array::Slot_array( std::uint32_t capacity ):
+slots( new Slot[capacity] ),
+slot_count( 0 ),
+slot_capacity( capacity )
+{ }
+
+/* Slot_array Destructor: ~Slot_array()
+	It releases the slots; the list has already destroyed the values in them
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::Slot_array::~Slot_array() {
+
+	delete [] slots;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                       Node handle functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+/* Node handle Constructor: Indexed_node( slots, index )
+	This constructor creates the handle of the slot index of a slot array
+*/
+
+template <typename Type>
+Indexed_sentinel_list<Type>::Indexed_node::Indexed_node( Slot_array *slots, std::uint32_t index ):
+node_slots( slots ),
+node_index( index )
+{ }
+
+/* Member function: value()
+	This member function returns a reference to the value of the node
+*/
+
+template <typename Type>
+Type &Indexed_sentinel_list<Type>::Indexed_node::value() const {
+
+	return *node_slots->slots[node_index].value();
+}
+
+/* Member function: previous()
+	This member function returns the handle of the previous node
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::Indexed_node::previous() const {
+
+	return Indexed_node( node_slots, node_slots->slots[node_index].previous_node );
+}
+
+/* Member function: next()
+	This member function returns the handle of the next node
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node Indexed_sentinel_list<Type>::Indexed_node::next() const {
+
+	return Indexed_node( node_slots, node_slots->slots[node_index].next_node );
+}
+
+/* Member function: index()
+	This member function returns the slot index of the node
+*/
+
+template <typename Type>
+std::uint32_t Indexed_sentinel_list<Type>::Indexed_node::index() const {
+
+	return node_index;
+}
+
+/* Member function: operator->()
+	This member function lets a handle be used with the pointer syntax of Double_node
+*/
+
+template <typename Type>
+typename Indexed_sentinel_list<Type>::Indexed_node const *Indexed_sentinel_list<Type>::Indexed_node::operator->() const {
+
+	return this;
+}
+
+template <typename Type>
+bool Indexed_sentinel_list<Type>::Indexed_node::operator==( Indexed_node const &rhs ) const {
+
+	return ( node_slots == rhs.node_slots and node_index == rhs.node_index );
+}
+
+template <typename Type>
+bool Indexed_sentinel_list<Type>::Indexed_node::operator!=( Indexed_node const &rhs ) const {
+
+	return !( *this == rhs );
+}
@@ -0,0 +1,587 @@
+#include <iostream>
+#include <cstddef>
+#include <memory>
+
+/* Intrusive_hook
+	The previous and next links of an object stored in an Intrusive_sentinel_list.
+	The user's class holds one hook per list it can be in, for example
+
+		class Job {
+			public:
+				int id;
+				Intrusive_hook hook;
+		};
+
+		Intrusive_sentinel_list<Job, &Job::hook> queue;
+
+	A hook that is not in a list has null links. Copying an object does not copy the
+	links: the copy starts unlinked and assignment leaves the links untouched.
+*/
+
+class Intrusive_hook {
+	public:
+		Intrusive_hook();
+		Intrusive_hook( Intrusive_hook const & );
+		Intrusive_hook &operator=( Intrusive_hook const & );
+
+		bool is_linked() const;
+		Intrusive_hook *previous() const;
+		Intrusive_hook *next() const;
+
+		Intrusive_hook *previous_node;
+		Intrusive_hook *next_node;
+};
+
+/* Intrusive_sentinel_list<Type, Hook>
+	A doubly linked list with head and tail sentinels, like Double_sentinel_list, whose
+	nodes are the hooks inside the user's objects. The list never allocates or copies:
+	the objects are owned by the user and must outlive their membership in the list.
+	The sentinels are members of the list, so begin(), end(), rbegin() and rend() return
+	hooks; value( hook ) gives the object that contains a (non-sentinel) hook of the list.
+	The offset of the hook inside Type is taken from the first object linked into the
+	list (and passed on with the objects when the list is moved or swapped).
+	A const list only gives const access to its objects.
+	When the list is destroyed every object still in it is unlinked.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+class Intrusive_sentinel_list {
+	public:
+
+		// Constructors
+
+		Intrusive_sentinel_list();
+		Intrusive_sentinel_list( Intrusive_sentinel_list const & ) = delete;
+		Intrusive_sentinel_list( Intrusive_sentinel_list && );
+		~Intrusive_sentinel_list();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+
+		Type &front();
+		Type const &front() const;
+		Type &back();
+		Type const &back() const;
+
+		Intrusive_hook *begin();
+		Intrusive_hook const *begin() const;
+		Intrusive_hook *end();
+		Intrusive_hook const *end() const;
+		Intrusive_hook *rbegin();
+		Intrusive_hook const *rbegin() const;
+		Intrusive_hook *rend();
+		Intrusive_hook const *rend() const;
+
+		Intrusive_hook *find( Type const & );
+		Intrusive_hook const *find( Type const & ) const;
+		int count( Type const & ) const;
+
+		Type &value( Intrusive_hook * );
+		Type const &value( Intrusive_hook const * ) const;
+
+		// Mutators
+
+		void swap( Intrusive_sentinel_list & );
+		Intrusive_sentinel_list &operator=( Intrusive_sentinel_list const & ) = delete;
+		Intrusive_sentinel_list &operator=( Intrusive_sentinel_list && );
+
+		void push_front( Type & );
+		void push_back( Type & );
+		void insert( Intrusive_hook *, Type & );
+
+		void pop_front();
+		void pop_back();
+
+		void unlink( Type & );
+		int erase( Type const & );
+		void clear();
+
+	private:
+		Intrusive_hook list_head;
+		Intrusive_hook list_tail;
+		int list_size;
+		std::ptrdiff_t hook_offset;
+
+		void link_before( Intrusive_hook *, Type & );
+		static void unlink_hook( Intrusive_hook * );
+		void take_chain( Intrusive_sentinel_list & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                      Public member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+/* Default Constructor: Intrusive_sentinel_list()
+	This is the default constructor that links the head and tail sentinels together
+	No errors are expected with this constructor
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_sentinel_list<Type, Hook>::Intrusive_sentinel_list():
+list_size( 0 ),
+hook_offset( 0 )
+{
+	list_head.next_node = &list_tail;
+	list_tail.previous_node = &list_head;
+}
+
+/* Move Constructor: Intrusive_sentinel_list( list )
+	This constructor relinks the objects of the argument list between the sentinels
+	of *this list. The argument list is left empty.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_sentinel_list<Type, Hook>::Intrusive_sentinel_list( Intrusive_sentinel_list<Type, Hook> &&list ):
+Intrusive_sentinel_list()
+{
+	take_chain( list );
+}
+
+/* Destructor: ~Intrusive_sentinel_list()
+	It unlinks every object still in the list. The objects are not destroyed.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_sentinel_list<Type, Hook>::~Intrusive_sentinel_list() {
+
+	clear();
+}
+
+/* Accessor: size()
+	This function returns the number of objects in the list
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+int Intrusive_sentinel_list<Type, Hook>::size() const {
+	return list_size;
+}
+
+/* Accessor: empty()
+	This function returns true if the list is empty, or false otherwise.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+bool Intrusive_sentinel_list<Type, Hook>::empty() const {
+	return ( list_size == 0 );
+}
+
+/* Accessor: front()
+	This function returns the first object in the list
+	Throws underflow if the list is empty
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Type &Intrusive_sentinel_list<Type, Hook>::front() {
+	if ( empty() ) throw underflow();
+
+	return value( list_head.next_node );
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Type const &Intrusive_sentinel_list<Type, Hook>::front() const {
+	if ( empty() ) throw underflow();
+
+	return value( list_head.next_node );
+}
+
+/* Accessor: back()
+	This function returns the last object in the list
+	Throws underflow if the list is empty
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Type &Intrusive_sentinel_list<Type, Hook>::back() {
+	if ( empty() ) throw underflow();
+
+	return value( list_tail.previous_node );
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Type const &Intrusive_sentinel_list<Type, Hook>::back() const {
+	if ( empty() ) throw underflow();
+
+	return value( list_tail.previous_node );
+}
+
+/* Accessor: begin()
+	This function returns the hook of the first object in the list
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook *Intrusive_sentinel_list<Type, Hook>::begin() {
+	return list_head.next_node;
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook const *Intrusive_sentinel_list<Type, Hook>::begin() const {
+	return list_head.next_node;
+}
+
+/* Accessor: end()
+	This function returns the tail sentinel
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook *Intrusive_sentinel_list<Type, Hook>::end() {
+	return &list_tail;
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook const *Intrusive_sentinel_list<Type, Hook>::end() const {
+	return &list_tail;
+}
+
+/* Accessor: rbegin()
+	This function returns the hook of the last object in the list
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook *Intrusive_sentinel_list<Type, Hook>::rbegin() {
+	return list_tail.previous_node;
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook const *Intrusive_sentinel_list<Type, Hook>::rbegin() const {
+	return list_tail.previous_node;
+}
+
+/* Accessor: rend()
+	This function returns the head sentinel
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook *Intrusive_sentinel_list<Type, Hook>::rend() {
+	return &list_head;
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook const *Intrusive_sentinel_list<Type, Hook>::rend() const {
+	return &list_head;
+}
+
+/* Accessor: find()
+	This function returns the hook of the first object in the list equal to the argument
+	It returns end() if none is found.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook *Intrusive_sentinel_list<Type, Hook>::find( Type const &obj ) {
+
+	for ( Intrusive_hook *hook = begin(); hook != end(); hook = hook->next_node ) {
+		if ( value( hook ) == obj ) return hook;
+	}
+
+	return end();
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_hook const *Intrusive_sentinel_list<Type, Hook>::find( Type const &obj ) const {
+
+	for ( Intrusive_hook const *hook = begin(); hook != end(); hook = hook->next_node ) {
+		if ( value( hook ) == obj ) return hook;
+	}
+
+	return end();
+}
+
+/* Accessor: count()
+	This function returns the number of objects in the list equal to the argument
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+int Intrusive_sentinel_list<Type, Hook>::count( Type const &obj ) const {
+
+	int cont = 0;
+
+	for ( Intrusive_hook const *hook = list_head.next_node; hook != &list_tail; hook = hook->next_node ) {
+		cont += ( value( hook ) == obj );
+	}
+
+	return cont;
+}
+
+/* Accessor: value( hook )
+	This function returns the object that contains the hook, which must be a (non-sentinel)
+	hook of this list. The object is found by going back hook_offset bytes, the offset of
+	the hook measured on an object linked into the list.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Type &Intrusive_sentinel_list<Type, Hook>::value( Intrusive_hook *hook ) {
+
+	return *reinterpret_cast<Type *>( reinterpret_cast<char *>( hook ) - hook_offset );
+}
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Type const &Intrusive_sentinel_list<Type, Hook>::value( Intrusive_hook const *hook ) const {
+
+	return *reinterpret_cast<Type const *>( reinterpret_cast<char const *>( hook ) - hook_offset );
+}
+
+/* Mutator: swap( Intrusive_sentinel_list<Type, Hook> &list )
+	This mutator exchanges the objects of *this list with those of the argument list.
+	The sentinels stay in place, so the first and last objects of each chain are relinked.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::swap( Intrusive_sentinel_list<Type, Hook> &list ) {
+
+	if ( &list == this ) return;
+
+	Intrusive_sentinel_list<Type, Hook> temp;
+	temp.take_chain( *this );
+	take_chain( list );
+	list.take_chain( temp );
+}
+
+/* Mutator: Move operator
+	This assignment operator unlinks the objects of *this list and takes the objects of
+	the argument list, which is left empty
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+Intrusive_sentinel_list<Type, Hook> &Intrusive_sentinel_list<Type, Hook>::operator=( Intrusive_sentinel_list<Type, Hook> &&rhs ) {
+
+	if ( &rhs != this ) {
+		clear();
+		take_chain( rhs );
+	}
+
+	return *this;
+}
+
+/* Mutator: push_front( Type &obj )
+	This mutator links obj at the front of the list. obj must not be in a list already.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::push_front( Type &obj ) {
+
+	link_before( list_head.next_node, obj );
+	list_size += 1;
+}
+
+/* Mutator: push_back( Type &obj )
+	This mutator links obj at the back of the list. obj must not be in a list already.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::push_back( Type &obj ) {
+
+	link_before( &list_tail, obj );
+	list_size += 1;
+}
+
+/* Mutator: insert( position, Type &obj )
+	This mutator links obj in front of position (a hook of this list, or end())
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::insert( Intrusive_hook *position, Type &obj ) {
+
+	link_before( position, obj );
+	list_size += 1;
+}
+
+/* Mutator: pop_front()
+	This mutator unlinks the first object of the list
+	Throws underflow() if the list is empty
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::pop_front() {
+
+	if ( empty() ) throw underflow();
+
+	unlink_hook( list_head.next_node );
+	list_size -= 1;
+}
+
+/* Mutator: pop_back()
+	This mutator unlinks the last object of the list
+	Throws underflow() if the list is empty
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::pop_back() {
+
+	if ( empty() ) throw underflow();
+
+	unlink_hook( list_tail.previous_node );
+	list_size -= 1;
+}
+
+/* Mutator: unlink( Type &obj )
+	This mutator unlinks obj, which must be in this list, in O(1)
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::unlink( Type &obj ) {
+
+	unlink_hook( &( obj.*Hook ) );
+	list_size -= 1;
+}
+
+/* Mutator: erase( Type const &obj )
+	This mutator unlinks all the objects in the list equal to the argument obj.
+	It returns the number of unlinked objects
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+int Intrusive_sentinel_list<Type, Hook>::erase( Type const &obj ) {
+
+	int cont = 0;
+	Intrusive_hook *hook = list_head.next_node;
+
+	while ( hook != &list_tail ) {
+		Intrusive_hook *next = hook->next_node;
+		if ( value( hook ) == obj ) {
+			unlink_hook( hook );
+			cont += 1;
+		}
+		hook = next;
+	}
+
+	list_size -= cont;
+	return cont;
+}
+
+/* Mutator: clear()
+	This mutator unlinks every object of the list, leaving their hooks with null links
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::clear() {
+
+	Intrusive_hook *hook = list_head.next_node;
+
+	while ( hook != &list_tail ) {
+		Intrusive_hook *next = hook->next_node;
+		hook->previous_node = nullptr;
+		hook->next_node = nullptr;
+		hook = next;
+	}
+
+	list_head.next_node = &list_tail;
+	list_tail.previous_node = &list_head;
+	list_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+/* Private member function: link_before( position, obj )
+	This function links the hook of obj in front of position, and records the offset of
+	the hook inside obj for value()
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::link_before( Intrusive_hook *position, Type &obj ) {
+
+	Intrusive_hook *hook = &( obj.*Hook );
+	hook_offset = reinterpret_cast<char *>( hook ) - reinterpret_cast<char *>( std::addressof( obj ) );
+
+	hook->previous_node = position->previous_node;
+	hook->next_node = position;
+	position->previous_node->next_node = hook;
+	position->previous_node = hook;
+}
+
+/* Private member function: unlink_hook( hook )
+	This function removes hook from its list and leaves it with null links
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::unlink_hook( Intrusive_hook *hook ) {
+
+	hook->previous_node->next_node = hook->next_node;
+	hook->next_node->previous_node = hook->previous_node;
+	hook->previous_node = nullptr;
+	hook->next_node = nullptr;
+}
+
+/* Private member function: take_chain( list )
+	This function moves the objects of the argument list between the sentinels of
+	*this list, which must be empty. The argument list is left empty.
+*/
+
+template <typename Type, Intrusive_hook Type::*Hook>
+void Intrusive_sentinel_list<Type, Hook>::take_chain( Intrusive_sentinel_list<Type, Hook> &list ) {
+
+	if ( list.empty() ) return;
+
+	Intrusive_hook *first = list.list_head.next_node;
+	Intrusive_hook *last = list.list_tail.previous_node;
+
+	list_head.next_node = first;
+	first->previous_node = &list_head;
+	list_tail.previous_node = last;
+	last->next_node = &list_tail;
+	list_size = list.list_size;
+	hook_offset = list.hook_offset;
+
+	list.list_head.next_node = &list.list_tail;
+	list.list_tail.previous_node = &list.list_head;
+	list.list_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                        Hook member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+/* Hook Constructor: Intrusive_hook()
+	This constructor creates an unlinked hook
+*/
+
+inline Intrusive_hook::Intrusive_hook():
+previous_node( nullptr ),
+next_node( nullptr )
+{ }
+
+/* Hook Copy Constructor: Intrusive_hook( hook )
+	The copy of an object is not in any list, so its hook starts unlinked
+*/
+
+inline Intrusive_hook::Intrusive_hook( Intrusive_hook const & ):
+previous_node( nullptr ),
+next_node( nullptr )
+{ }
+
+/* Hook Assignment operator
+	Assigning an object does not change the lists it is in
+*/
+
+inline Intrusive_hook &Intrusive_hook::operator=( Intrusive_hook const & ) {
+
+	return *this;
+}
+
+/* Member function: is_linked()
+	This member function returns true if the hook is in a list
+*/
+
+inline bool Intrusive_hook::is_linked() const {
+
+	return ( next_node != nullptr );
+}
+
+/* Member function: previous()
+	This member function returns the previous pointer
+*/
+
+inline Intrusive_hook *Intrusive_hook::previous() const {
+
+	return previous_node;
+}
+
+/* Member function: next()
+	This member function returns the next pointer
+*/
+
+inline Intrusive_hook *Intrusive_hook::next() const {
+
+	return next_node;
+}
@@ -0,0 +1,194 @@
+// Benchmark of Intrusive_sentinel_list against the owning Double_sentinel_list, for jobs
+// that already live in an arena (a std::vector) as they do in a scheduler.
+//
+// Build:	g++ -std=c++17 -O2 1_Intrusive_sentinel_list_benchmark.cpp -o intrusive_benchmark
+// Run:		./intrusive_benchmark [jobs (default 1000000)] [rounds (default 10)]
+//
+// Three lists are compared:
+//	intrusive	Intrusive_sentinel_list<Job, &Job::hook>, which links the jobs themselves
+//	owning copy	Double_sentinel_list<Job>, which allocates a node and copies the job into it
+//	owning pointer	Double_sentinel_list<Job *>, which allocates a node holding a pointer
+// and the tests, each printed in nanoseconds per job, are
+//	queue		push_back every job, then pop_front every job
+//	unlink		push_back every job, then remove them in a random order, by object for the
+//			intrusive list and through the node returned when it was inserted otherwise
+//	traverse	sum the ids of the jobs by walking a list that holds every job
+// The jobs are linked in a random order, so the intrusive list walks the arena out of order.
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// The exceptions thrown by the lists
+class underflow {};
+class overflow {};
+class illegal_argument {};
+
+#include "1_Double_sentinel_list.h"
+#include "1_Intrusive_sentinel_list.h"
+
+/*
+	A job of a scheduler: a few words of state and the hook of the run queue
+*/
+class Job {
+	public:
+		int id;
+		int priority;
+		std::int64_t payload[4];
+		Intrusive_hook hook;
+};
+
+using Intrusive_list = Intrusive_sentinel_list<Job, &Job::hook>;
+using Copy_list = Double_sentinel_list<Job>;
+using Pointer_list = Double_sentinel_list<Job *>;
+
+static double elapsed( std::chrono::steady_clock::time_point start ) {
+	return std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Keeps the compiler from dropping the values read by the tests
+static volatile std::int64_t sink;
+
+/*
+	The adapters give the three lists one interface for the tests
+*/
+static void push( Intrusive_list &list, Job &job ) { list.push_back( job ); }
+static void push( Copy_list &list, Job &job ) { list.push_back( job ); }
+static void push( Pointer_list &list, Job &job ) { list.push_back( &job ); }
+
+static int front_id( Intrusive_list &list ) { return list.front().id; }
+static int front_id( Copy_list &list ) { return list.front().id; }
+static int front_id( Pointer_list &list ) { return list.front()->id; }
+
+static std::int64_t sum_ids( Intrusive_list const &list ) {
+	std::int64_t sum = 0;
+	for ( Intrusive_hook const *hook = list.begin(); hook != list.end(); hook = hook->next() ) {
+		sum += list.value( hook ).id;
+	}
+	return sum;
+}
+
+static std::int64_t sum_ids( Copy_list const &list ) {
+	std::int64_t sum = 0;
+	for ( auto *node = list.begin(); node != list.end(); node = node->next() ) sum += node->value().id;
+	return sum;
+}
+
+static std::int64_t sum_ids( Pointer_list const &list ) {
+	std::int64_t sum = 0;
+	for ( auto *node = list.begin(); node != list.end(); node = node->next() ) sum += node->value()->id;
+	return sum;
+}
+
+/*
+	The tests, returning nanoseconds per job
+*/
+template <typename List>
+double queue_test( std::vector<Job> &arena, std::vector<int> const &order, int rounds ) {
+	List list;
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( int round = 0; round < rounds; ++round ) {
+		for ( int i: order ) push( list, arena[i] );
+		while ( !list.empty() ) {
+			sum += front_id( list );
+			list.pop_front();
+		}
+	}
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/( static_cast<double>( rounds )*order.size() );
+}
+
+static double unlink_intrusive( std::vector<Job> &arena, std::vector<int> const &order, std::vector<int> const &removal, int rounds ) {
+	Intrusive_list list;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( int round = 0; round < rounds; ++round ) {
+		for ( int i: order ) list.push_back( arena[i] );
+		for ( int i: removal ) list.unlink( arena[i] );
+	}
+
+	double ns = elapsed( start );
+	return ns/( static_cast<double>( rounds )*order.size() );
+}
+
+template <typename List, typename Make>
+double unlink_owning( std::vector<Job> &arena, std::vector<int> const &order, std::vector<int> const &removal, int rounds, Make make ) {
+	List list;
+	std::vector<typename List::Double_node *> nodes( arena.size() );
+	auto start = std::chrono::steady_clock::now();
+
+	for ( int round = 0; round < rounds; ++round ) {
+		for ( int i: order ) nodes[i] = list.emplace( list.end(), make( arena[i] ) );
+		for ( int i: removal ) list.erase( nodes[i] );
+	}
+
+	double ns = elapsed( start );
+	return ns/( static_cast<double>( rounds )*order.size() );
+}
+
+template <typename List>
+double traverse_test( std::vector<Job> &arena, std::vector<int> const &order, int rounds ) {
+	List list;
+	for ( int i: order ) push( list, arena[i] );
+
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( int round = 0; round < rounds; ++round ) sum += sum_ids( list );
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/( static_cast<double>( rounds )*order.size() );
+}
+
+static void print( std::string const &name, double queue, double unlink, double traverse ) {
+	std::cout << std::left << std::setw( 16 ) << name << std::right << std::fixed << std::setprecision( 2 )
+	          << std::setw( 12 ) << queue << std::setw( 12 ) << unlink << std::setw( 12 ) << traverse << std::endl;
+}
+
+int main( int argc, char **argv ) {
+	int jobs = ( argc > 1 ) ? std::atoi( argv[1] ) : 1000000;
+	int rounds = ( argc > 2 ) ? std::atoi( argv[2] ) : 10;
+
+	std::vector<Job> arena( jobs );
+	for ( int i = 0; i < jobs; ++i ) {
+		arena[i].id = i;
+		arena[i].priority = i % 8;
+	}
+
+	std::mt19937 random( 42 );
+	std::vector<int> order( jobs );
+	std::iota( order.begin(), order.end(), 0 );
+	std::shuffle( order.begin(), order.end(), random );
+	std::vector<int> removal( order );
+	std::shuffle( removal.begin(), removal.end(), random );
+
+	std::cout << "ns per job, " << jobs << " jobs" << std::endl
+	          << std::left << std::setw( 16 ) << "list" << std::right
+	          << std::setw( 12 ) << "queue" << std::setw( 12 ) << "unlink" << std::setw( 12 ) << "traverse" << std::endl;
+
+	print( "intrusive",
+		queue_test<Intrusive_list>( arena, order, rounds ),
+		unlink_intrusive( arena, order, removal, rounds ),
+		traverse_test<Intrusive_list>( arena, order, rounds ) );
+	print( "owning copy",
+		queue_test<Copy_list>( arena, order, rounds ),
+		unlink_owning<Copy_list>( arena, order, removal, rounds, []( Job &job ) -> Job const & { return job; } ),
+		traverse_test<Copy_list>( arena, order, rounds ) );
+	print( "owning pointer",
+		queue_test<Pointer_list>( arena, order, rounds ),
+		unlink_owning<Pointer_list>( arena, order, removal, rounds, []( Job &job ) { return &job; } ),
+		traverse_test<Pointer_list>( arena, order, rounds ) );
+
+	return 0;
+}
@@ -0,0 +1,294 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && defined( __GNUC__ )
+#define SIMD_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+/* Simd_search
+	Search kernels over a contiguous array of n values, used by the lists that store
+	their values contiguously (Unrolled_sentinel_list).
+	For arithmetic types of 1, 2, 4 or 8 bytes the values are compared 16 or 32 bytes at
+	a time with compare-and-movemask instructions. The AVX2 kernel is selected at run time
+	if the processor supports it, otherwise the SSE2 kernel is used. Every other type (and
+	every other platform) uses the scalar loop with operator==.
+	The floating point kernels use an ordered compare, so they agree with operator==
+	(0.0 == -0.0 and NaN never matches).
+*/
+
+class Simd_search {
+	public:
+		template <typename Type>
+		static int find( Type const *, int, Type const & );
+
+		template <typename Type>
+		static int count( Type const *, int, Type const & );
+
+	private:
+		template <typename Type>
+		static constexpr bool vectorizable();
+
+		static bool has_avx2();
+
+		template <typename Type>
+		static int find_scalar( Type const *, int, Type const & );
+		template <typename Type>
+		static int count_scalar( Type const *, int, Type const & );
+
+#ifdef SIMD_SEARCH_X86
+		template <typename Type>
+		static int find_sse2( Type const *, int, Type const & );
+		template <typename Type>
+		static int count_sse2( Type const *, int, Type const & );
+		template <typename Type>
+		static int find_avx2( Type const *, int, Type const & );
+		template <typename Type>
+		static int count_avx2( Type const *, int, Type const & );
+
+		template <typename Type>
+		static int mask_sse2( __m128i, __m128i );
+		template <typename Type>
+		static int mask_avx2( __m256i, __m256i );
+		template <typename Type>
+		static int bits_per_value();
+#endif
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                      Public member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+/* Function: find( values, n, obj )
+	This function returns the index of the first value in values[0], ..., values[n - 1]
+	equal to obj, or n if there is none.
+*/
+
+template <typename Type>
+int Simd_search::find( Type const *values, int n, Type const &obj ) {
+
+#ifdef SIMD_SEARCH_X86
+	if constexpr ( vectorizable<Type>() ) {
+		return has_avx2() ? find_avx2( values, n, obj ) : find_sse2( values, n, obj );
+	}
+#endif
+
+	return find_scalar( values, n, obj );
+}
+
+/* Function: count( values, n, obj )
+	This function returns the number of values in values[0], ..., values[n - 1] equal to obj
+*/
+
+template <typename Type>
+int Simd_search::count( Type const *values, int n, Type const &obj ) {
+
+#ifdef SIMD_SEARCH_X86
+	if constexpr ( vectorizable<Type>() ) {
+		return has_avx2() ? count_avx2( values, n, obj ) : count_sse2( values, n, obj );
+	}
+#endif
+
+	return count_scalar( values, n, obj );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+/* Private member function: vectorizable<Type>()
+	Arithmetic types of 1, 2, 4 or 8 bytes can be compared by the vector kernels
+*/
+
+template <typename Type>
+constexpr bool Simd_search::vectorizable() {
+
+	return std::is_arithmetic<Type>::value and
+	       ( sizeof( Type ) == 1 or sizeof( Type ) == 2 or sizeof( Type ) == 4 or sizeof( Type ) == 8 );
+}
+
+/* Private member function: has_avx2()
+	This function checks once whether the processor supports AVX2
+*/
+
+inline bool Simd_search::has_avx2() {
+
+#ifdef SIMD_SEARCH_X86
+	static bool const avx2 = __builtin_cpu_supports( "avx2" );
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+template <typename Type>
+int Simd_search::find_scalar( Type const *values, int n, Type const &obj ) {
+
+	int i = 0;
+	while ( i < n and !( values[i] == obj ) ) ++i;
+	return i;
+}
+
+template <typename Type>
+int Simd_search::count_scalar( Type const *values, int n, Type const &obj ) {
+
+	int cont = 0;
+	for ( int i = 0; i < n; ++i ) {
+		cont += ( values[i] == obj );
+	}
+	return cont;
+}
+
+#ifdef SIMD_SEARCH_X86
+
+/* Private member function: bits_per_value<Type>()
+	Number of bits set in a movemask for every matching value: the integer kernels
+	use a byte mask, the floating point kernels a mask with one bit per value
+*/
+
+template <typename Type>
+int Simd_search::bits_per_value() {
+
+	return std::is_floating_point<Type>::value ? 1 : sizeof( Type );
+}
+
+/* Private member function: mask_sse2<Type>( block, key )
+	This function compares 16 bytes of values with the broadcast key and returns the movemask
+	There is no 64-bit integer compare in SSE2: the 32-bit halves are compared and a
+	value matches only if both halves match.
+*/
+
+template <typename Type>
+int Simd_search::mask_sse2( __m128i block, __m128i key ) {
+
+	if constexpr ( std::is_same<Type, float>::value ) {
+		return _mm_movemask_ps( _mm_cmpeq_ps( _mm_castsi128_ps( block ), _mm_castsi128_ps( key ) ) );
+	}
+	else if constexpr ( std::is_same<Type, double>::value ) {
+		return _mm_movemask_pd( _mm_cmpeq_pd( _mm_castsi128_pd( block ), _mm_castsi128_pd( key ) ) );
+	}
+	else if constexpr ( sizeof( Type ) == 1 ) {
+		return _mm_movemask_epi8( _mm_cmpeq_epi8( block, key ) );
+	}
+	else if constexpr ( sizeof( Type ) == 2 ) {
+		return _mm_movemask_epi8( _mm_cmpeq_epi16( block, key ) );
+	}
+	else if constexpr ( sizeof( Type ) == 4 ) {
+		return _mm_movemask_epi8( _mm_cmpeq_epi32( block, key ) );
+	}
+	else {
+		__m128i halves = _mm_cmpeq_epi32( block, key );
+		__m128i both = _mm_and_si128( halves, _mm_shuffle_epi32( halves, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		return _mm_movemask_epi8( both );
+	}
+}
+
+/* Private member function: mask_avx2<Type>( block, key )
+	This function compares 32 bytes of values with the broadcast key and returns the movemask
+*/
+
+template <typename Type>
+__attribute__(( target( "avx2" ) ))
+int Simd_search::mask_avx2( __m256i block, __m256i key ) {
+
+	if constexpr ( std::is_same<Type, float>::value ) {
+		return _mm256_movemask_ps( _mm256_cmp_ps( _mm256_castsi256_ps( block ), _mm256_castsi256_ps( key ), _CMP_EQ_OQ ) );
+	}
+	else if constexpr ( std::is_same<Type, double>::value ) {
+		return _mm256_movemask_pd( _mm256_cmp_pd( _mm256_castsi256_pd( block ), _mm256_castsi256_pd( key ), _CMP_EQ_OQ ) );
+	}
+	else if constexpr ( sizeof( Type ) == 1 ) {
+		return _mm256_movemask_epi8( _mm256_cmpeq_epi8( block, key ) );
+	}
+	else if constexpr ( sizeof( Type ) == 2 ) {
+		return _mm256_movemask_epi8( _mm256_cmpeq_epi16( block, key ) );
+	}
+	else if constexpr ( sizeof( Type ) == 4 ) {
+		return _mm256_movemask_epi8( _mm256_cmpeq_epi32( block, key ) );
+	}
+	else {
+		return _mm256_movemask_epi8( _mm256_cmpeq_epi64( block, key ) );
+	}
+}
+
+template <typename Type>
+int Simd_search::find_sse2( Type const *values, int n, Type const &obj ) {
+
+	int const width = 16/sizeof( Type );
+	__m128i key;
+	for ( int k = 0; k < width; ++k ) {
+		std::memcpy( reinterpret_cast<char *>( &key ) + k*sizeof( Type ), &obj, sizeof( Type ) );
+	}
+
+	int i = 0;
+	for ( ; i + width <= n; i += width ) {
+		int mask = mask_sse2<Type>( _mm_loadu_si128( reinterpret_cast<__m128i const *>( values + i ) ), key );
+		if ( mask != 0 ) return i + __builtin_ctz( mask )/bits_per_value<Type>();
+	}
+
+	return i + find_scalar( values + i, n - i, obj );
+}
+
+template <typename Type>
+int Simd_search::count_sse2( Type const *values, int n, Type const &obj ) {
+
+	int const width = 16/sizeof( Type );
+	__m128i key;
+	for ( int k = 0; k < width; ++k ) {
+		std::memcpy( reinterpret_cast<char *>( &key ) + k*sizeof( Type ), &obj, sizeof( Type ) );
+	}
+
+	long long bits = 0;
+	int i = 0;
+	for ( ; i + width <= n; i += width ) {
+		bits += __builtin_popcount( mask_sse2<Type>( _mm_loadu_si128( reinterpret_cast<__m128i const *>( values + i ) ), key ) );
+	}
+
+	return bits/bits_per_value<Type>() + count_scalar( values + i, n - i, obj );
+}
+
+template <typename Type>
+__attribute__(( target( "avx2" ) ))
+int Simd_search::find_avx2( Type const *values, int n, Type const &obj ) {
+
+	int const width = 32/sizeof( Type );
+	__m256i key;
+	for ( int k = 0; k < width; ++k ) {
+		std::memcpy( reinterpret_cast<char *>( &key ) + k*sizeof( Type ), &obj, sizeof( Type ) );
+	}
+
+	int i = 0;
+	for ( ; i + width <= n; i += width ) {
+		int mask = mask_avx2<Type>( _mm256_loadu_si256( reinterpret_cast<__m256i const *>( values + i ) ), key );
+		if ( mask != 0 ) return i + __builtin_ctz( mask )/bits_per_value<Type>();
+	}
+
+	return i + find_scalar( values + i, n - i, obj );
+}
+
+template <typename Type>
+__attribute__(( target( "avx2" ) ))
+int Simd_search::count_avx2( Type const *values, int n, Type const &obj ) {
+
+	int const width = 32/sizeof( Type );
+	__m256i key;
+	for ( int k = 0; k < width; ++k ) {
+		std::memcpy( reinterpret_cast<char *>( &key ) + k*sizeof( Type ), &obj, sizeof( Type ) );
+	}
+
+	long long bits = 0;
+	int i = 0;
+	for ( ; i + width <= n; i += width ) {
+		bits += __builtin_popcount( mask_avx2<Type>( _mm256_loadu_si256( reinterpret_cast<__m256i const *>( values + i ) ), key ) );
+	}
+
+	return bits/bits_per_value<Type>() + count_scalar( values + i, n - i, obj );
+}
+
+#endif
+
+#endif
@@ -0,0 +1,615 @@
+#ifndef UNROLLED_SENTINEL_LIST_H
+#define UNROLLED_SENTINEL_LIST_H
+
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include "1_Simd_search.h"
+
+/* Unrolled_sentinel_list<Type, N>
+	A doubly linked list with head and tail sentinels, like Double_sentinel_list, where
+	every node stores up to N values in a contiguous array instead of a single value.
+	Scans (find, count, erase) walk the array of each node with the Simd_search kernels
+	and only follow a pointer every N elements.
+	The values of a node are kept at the consecutive positions node_start, ...,
+	node_start + size() - 1 of its array, so pop_front() and pop_back() only move one end
+	of the run, and push_front() and push_back() only shift the values (to the middle of
+	the array) when the run has reached that end of the array.
+	A slot left by a removed value is assigned a default constructed value, so it does not
+	keep the resources of the old value until the node is deleted.
+	Nodes that become empty are removed, and a node that drops below half full is merged
+	with its neighbour when both fit in one node.
+*/
+
+template <typename Type, int N = 16>
+class Unrolled_sentinel_list {
+	static_assert( N > 1, "An unrolled node must hold at least two values" );
+
+	public:
+		class Unrolled_node {
+			public:
+				Unrolled_node( Unrolled_node * = nullptr, Unrolled_node * = nullptr );
+
+				Type value( int ) const;
+				int size() const;
+				Unrolled_node *previous() const;
+				Unrolled_node *next() const;
+
+				Type           node_values[N];
+				int            node_start;
+				int            node_count;
+				Unrolled_node *previous_node;
+				Unrolled_node *next_node;
+		};
+
+		// Constructors
+
+		Unrolled_sentinel_list();
+		Unrolled_sentinel_list( Unrolled_sentinel_list const & );
+		Unrolled_sentinel_list( Unrolled_sentinel_list && );
+		~Unrolled_sentinel_list();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+
+		Type front() const;
+		Type back() const;
+
+		Unrolled_node *begin() const;
+		Unrolled_node *end() const;
+		Unrolled_node *rbegin() const;
+		Unrolled_node *rend() const;
+
+		Unrolled_node *find( Type const & ) const;
+		int count( Type const & ) const;
+
+		// Mutators
+
+		void swap( Unrolled_sentinel_list & );
+		Unrolled_sentinel_list &operator=( Unrolled_sentinel_list const & );
+		Unrolled_sentinel_list &operator=( Unrolled_sentinel_list && );
+
+		void push_front( Type const & );
+		void push_back( Type const & );
+
+		void pop_front();
+		void pop_back();
+
+		int erase( Type const & );
+
+	private:
+		Unrolled_node *list_head;
+		Unrolled_node *list_tail;
+		int list_size;
+
+		Unrolled_node *insert_node( Unrolled_node * );
+		void remove_node( Unrolled_node * );
+		bool merge_next( Unrolled_node * );
+		static Type const *shift_values( Unrolled_node *, int, Type const * = nullptr );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                      Public member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+/* Default Constructor: Unrolled_sentinel_list()
+	This is the default constructor that creates the head and tail sentinel nodes
+	The sentinels never store values (their node_count is 0)
+	No errors are expected with this constructor
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N>::Unrolled_sentinel_list():
+list_head( new Unrolled_node ),
+list_tail( new Unrolled_node ),
+list_size( 0 )
+{
+	list_head->next_node = list_tail;
+	list_tail->previous_node = list_head;
+}
+
+/* Copy Constructor: Unrolled_sentinel_list( list )
+	This constructor creates a new list with the sentinels and one node for every
+	node of the argument list, storing the same values in the same order
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N>::Unrolled_sentinel_list( Unrolled_sentinel_list<Type, N> const &list ):
+Unrolled_sentinel_list()
+{
+	for ( Unrolled_node *node = list.begin(); node != list.end(); node = node->next_node ) {
+		Unrolled_node *copy = insert_node( list_tail );
+		for ( int i = node->node_start; i < node->node_start + node->node_count; ++i ) {
+			copy->node_values[i] = node->node_values[i];
+		}
+		copy->node_start = node->node_start;
+		copy->node_count = node->node_count;
+	}
+	list_size = list.list_size;
+}
+
+/* Move Constructor: Unrolled_sentinel_list( list )
+	This constructor takes the nodes of the argument list, which is left as an empty list
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N>::Unrolled_sentinel_list( Unrolled_sentinel_list<Type, N> &&list ):
+Unrolled_sentinel_list()
+{
+	this->swap( list );
+}
+
+/* Destructor: ~Unrolled_sentinel_list()
+	It deletes all the nodes in the list, including the sentinels.
+	No errors are expected with this destructor
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N>::~Unrolled_sentinel_list() {
+
+	Unrolled_node *current_node = list_head;
+	while ( current_node != nullptr ) {
+		Unrolled_node *temp_node = current_node;
+		current_node = current_node->next_node;
+		delete temp_node;
+	}
+}
+
+/* Accessor: size()
+	This function returns the number of values stored in the list (not the number of nodes)
+*/
+
+template <typename Type, int N>
+int Unrolled_sentinel_list<Type, N>::size() const {
+	return list_size;
+}
+
+/* Accessor: empty()
+	This function returns true if the list is empty, or false otherwise.
+*/
+
+template <typename Type, int N>
+bool Unrolled_sentinel_list<Type, N>::empty() const {
+	return ( list_size == 0 );
+}
+
+/* Accessor: front()
+	This function returns the first value of the first node
+	Throws underflow if the list is empty
+*/
+
+template <typename Type, int N>
+Type Unrolled_sentinel_list<Type, N>::front() const {
+	if ( empty() ) throw underflow();
+
+	Unrolled_node *first = list_head->next_node;
+	return first->node_values[first->node_start];
+}
+
+/* Accessor: back()
+	This function returns the last value of the last node
+	Throws underflow if the list is empty
+*/
+
+template <typename Type, int N>
+Type Unrolled_sentinel_list<Type, N>::back() const {
+	if ( empty() ) throw underflow();
+
+	Unrolled_node *last = list_tail->previous_node;
+	return last->node_values[last->node_start + last->node_count - 1];
+}
+
+/* Accessor: begin()
+	This function returns the address of the first node in the list
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::begin() const {
+	return list_head->next_node;
+}
+
+/* Accessor: end()
+	This function returns the address of the tail sentinel node
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::end() const {
+	return list_tail;
+}
+
+/* Accessor: rbegin()
+	This function returns the address of the last node in the list
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::rbegin() const {
+	return list_tail->previous_node;
+}
+
+/* Accessor: rend()
+	This function returns the address of the head sentinel
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::rend() const {
+	return list_head;
+}
+
+/* Accessor: find()
+	This function returns the address of the first node storing a value equal to the argument
+	It returns end() if none is found.
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::find( Type const &obj ) const {
+
+	for ( Unrolled_node *node = begin(); node != end(); node = node->next_node ) {
+		if ( Simd_search::find( node->node_values + node->node_start, node->node_count, obj ) != node->node_count ) return node;
+	}
+
+	return end();
+}
+
+/* Accessor: count()
+	This function returns the number of values in the list equal to the argument
+*/
+
+template <typename Type, int N>
+int Unrolled_sentinel_list<Type, N>::count( Type const &obj ) const {
+
+	int cont = 0;
+
+	for ( Unrolled_node *node = begin(); node != end(); node = node->next_node ) {
+		cont += Simd_search::count( node->node_values + node->node_start, node->node_count, obj );
+	}
+
+	return cont;
+}
+
+/* Mutator: swap( Unrolled_sentinel_list<Type, N> &list )
+	This mutator swaps all the member variables of *this list with those of the argument list
+*/
+
+template <typename Type, int N>
+void Unrolled_sentinel_list<Type, N>::swap( Unrolled_sentinel_list<Type, N> &list ) {
+
+	std::swap( list_head, list.list_head );
+	std::swap( list_tail, list.list_tail );
+	std::swap( list_size, list.list_size );
+}
+
+/* Mutator: Assignment operator
+	This assignment operator copies the argument list into the *this list
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N> &Unrolled_sentinel_list<Type, N>::operator=( Unrolled_sentinel_list<Type, N> const &rhs ) {
+
+	Unrolled_sentinel_list<Type, N> copy( rhs );
+	swap( copy );
+
+	return *this;
+}
+
+/* Mutator: Move operator
+	This assignment operator moves the nodes of the argument list into *this list
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N> &Unrolled_sentinel_list<Type, N>::operator=( Unrolled_sentinel_list<Type, N> &&rhs ) {
+
+	swap( rhs );
+
+	return *this;
+}
+
+/* Mutator: push_front( Type const &obj )
+	This mutator inserts obj before the first value of the list.
+	If the first node is full, a new node is linked at the front of the list and filled
+	from the end of its array. If the values of the first node start at position 0, they
+	are first shifted to the middle of the array.
+*/
+
+template <typename Type, int N>
+void Unrolled_sentinel_list<Type, N>::push_front( Type const &obj ) {
+
+	Unrolled_node *node = list_head->next_node;
+	Type const *source = std::addressof( obj );
+
+	if ( node == list_tail or node->node_count == N ) {
+		node = insert_node( node );
+		node->node_start = N;
+	}
+	else if ( node->node_start == 0 ) {
+		source = shift_values( node, ( N - node->node_count + 1 )/2, source );
+	}
+
+	node->node_values[node->node_start - 1] = *source;
+	node->node_start -= 1;
+	node->node_count += 1;
+	list_size += 1;
+}
+
+/* Mutator: push_back( Type const &obj )
+	This mutator inserts obj after the last value of the list.
+	If the last node is full, a new node is linked at the back of the list. If the values
+	of the last node reach the end of its array, they are first shifted to the middle.
+*/
+
+template <typename Type, int N>
+void Unrolled_sentinel_list<Type, N>::push_back( Type const &obj ) {
+
+	Unrolled_node *node = list_tail->previous_node;
+	Type const *source = std::addressof( obj );
+
+	if ( node == list_head or node->node_count == N ) {
+		node = insert_node( list_tail );
+	}
+	else if ( node->node_start + node->node_count == N ) {
+		source = shift_values( node, ( N - node->node_count )/2, source );
+	}
+
+	node->node_values[node->node_start + node->node_count] = *source;
+	node->node_count += 1;
+	list_size += 1;
+}
+
+/* Mutator: pop_front()
+	This mutator removes the first value of the list in O(1): the run of values of the
+	first node now starts one position later.
+	The first node is removed when it becomes empty, or merged with the next one
+	when it drops below half full and both fit in one node.
+	Throws underflow() if the list is empty
+*/
+
+template <typename Type, int N>
+void Unrolled_sentinel_list<Type, N>::pop_front() {
+
+	if ( empty() ) throw underflow();
+
+	Unrolled_node *node = list_head->next_node;
+
+	node->node_values[node->node_start] = Type();
+	node->node_start += 1;
+	node->node_count -= 1;
+	list_size -= 1;
+
+	if ( node->node_count == 0 ) {
+		remove_node( node );
+	}
+	else if ( node->node_count < N/2 ) {
+		merge_next( node );
+	}
+}
+
+/* Mutator: pop_back()
+	This mutator removes the last value of the list
+	The last node is removed when it becomes empty, or merged into the previous one
+	when it drops below half full and both fit in one node.
+	Throws underflow() if the list is empty
+*/
+
+template <typename Type, int N>
+void Unrolled_sentinel_list<Type, N>::pop_back() {
+
+	if ( empty() ) throw underflow();
+
+	Unrolled_node *node = list_tail->previous_node;
+
+	node->node_values[node->node_start + node->node_count - 1] = Type();
+	node->node_count -= 1;
+	list_size -= 1;
+
+	if ( node->node_count == 0 ) {
+		remove_node( node );
+	}
+	else if ( node->node_count < N/2 ) {
+		merge_next( node->previous_node );
+	}
+}
+
+/* Mutator: erase( Type const &obj )
+	This mutator removes all the values in the list equal to the argument obj.
+	Every node is compacted in place, and then merged into the previous node
+	if both fit in one node, so the list stays dense after large erasures.
+	It returns the number of removed values
+*/
+
+template <typename Type, int N>
+int Unrolled_sentinel_list<Type, N>::erase( Type const &obj ) {
+
+	int cont = 0;
+	Unrolled_node *node = list_head->next_node;
+
+	while ( node != list_tail ) {
+		Unrolled_node *next = node->next_node;
+
+		// Values before the first match stay where they are
+		Type *values = node->node_values + node->node_start;
+		int kept = Simd_search::find( values, node->node_count, obj );
+
+		for ( int i = kept + 1; i < node->node_count; ++i ) {
+			if ( values[i] != obj ) {
+				values[kept] = std::move( values[i] );
+				kept += 1;
+			}
+		}
+
+		for ( int i = kept; i < node->node_count; ++i ) {
+			values[i] = Type();
+		}
+
+		cont += node->node_count - kept;
+		node->node_count = kept;
+
+		if ( kept == 0 ) {
+			remove_node( node );
+		}
+		else {
+			merge_next( node->previous_node );
+		}
+
+		node = next;
+	}
+
+	list_size -= cont;
+	return cont;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+/* Private member function: insert_node( Unrolled_node *position )
+	This function links a new empty node in front of position and returns it
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::insert_node( Unrolled_node *position ) {
+
+	Unrolled_node *node = new Unrolled_node( position->previous_node, position );
+	position->previous_node->next_node = node;
+	position->previous_node = node;
+	return node;
+}
+
+/* Private member function: remove_node( Unrolled_node *node )
+	This function unlinks a (non-sentinel) node and deletes it
+*/
+
+template <typename Type, int N>
+void Unrolled_sentinel_list<Type, N>::remove_node( Unrolled_node *node ) {
+
+	node->previous_node->next_node = node->next_node;
+	node->next_node->previous_node = node->previous_node;
+	delete node;
+}
+
+/* Private member function: merge_next( Unrolled_node *node )
+	This function moves the values of the node following the argument into the
+	argument node and removes it, if both are data nodes and their values fit in one node.
+	The values of the argument node are first shifted to position 0 if there is not
+	enough room after them.
+	It returns true if the nodes were merged
+*/
+
+template <typename Type, int N>
+bool Unrolled_sentinel_list<Type, N>::merge_next( Unrolled_node *node ) {
+
+	Unrolled_node *next = node->next_node;
+
+	if ( node == list_head or next == list_tail or node->node_count + next->node_count > N ) {
+		return false;
+	}
+
+	if ( node->node_start + node->node_count + next->node_count > N ) {
+		shift_values( node, 0 );
+	}
+
+	Type *first = next->node_values + next->node_start;
+	std::move( first, first + next->node_count, node->node_values + node->node_start + node->node_count );
+	node->node_count += next->node_count;
+	remove_node( next );
+	return true;
+}
+
+/* Private member function: shift_values( Unrolled_node *node, int start, value )
+	This function moves the values of the node so that they begin at position start,
+	and resets the slots they leave with default constructed values.
+	It returns the new address of value if it is one of the moved values (a push of a
+	value of the same node), or value unchanged otherwise
+*/
+
+template <typename Type, int N>
+Type const *Unrolled_sentinel_list<Type, N>::shift_values( Unrolled_node *node, int start, Type const *value ) {
+
+	Type *first = node->node_values + node->node_start;
+	Type *last = first + node->node_count;
+	Type *destination = node->node_values + start;
+
+	if ( destination < first ) {
+		std::move( first, last, destination );
+		for ( Type *vacated = std::max( destination + node->node_count, first ); vacated != last; ++vacated ) {
+			*vacated = Type();
+		}
+	}
+	else if ( destination > first ) {
+		std::move_backward( first, last, destination + node->node_count );
+		for ( Type *vacated = first; vacated != std::min( destination, last ); ++vacated ) {
+			*vacated = Type();
+		}
+	}
+
+	if ( !std::less<Type const *>()( value, first ) and std::less<Type const *>()( value, last ) ) {
+		value += destination - first;
+	}
+
+	node->node_start = start;
+	return value;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                        Node member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+/* Node Constructor: Unrolled_node( pn, nn )
+	This is the constructor for the nodes in the list, it creates an empty node
+	pn -> Pointer to the previous Unrolled_node
+	nn -> Pointer to the next Unrolled_node
+*/
+
+template <typename Type, int N>
+Unrolled_sentinel_list<Type, N>::Unrolled_node::Unrolled_node(
+	typename Unrolled_sentinel_list<Type, N>::Unrolled_node *pn,
+	typename Unrolled_sentinel_list<Type, N>::Unrolled_node *nn ):
+node_start( 0 ),
+node_count( 0 ),
+previous_node( pn ),
+next_node( nn )
+{ }
+
+/* Member function: value( i )
+	This member function returns the i-th value stored in the node
+*/
+
+template <typename Type, int N>
+Type Unrolled_sentinel_list<Type, N>::Unrolled_node::value( int i ) const {
+
+	return node_values[node_start + i];
+}
+
+/* Member function: size()
+	This member function returns the number of values stored in the node
+*/
+
+template <typename Type, int N>
+int Unrolled_sentinel_list<Type, N>::Unrolled_node::size() const {
+
+	return node_count;
+}
+
+/* Member function: previous()
+	This member function returns the previous pointer
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::Unrolled_node::previous() const {
+
+	return previous_node;
+}
+
+/* Member function: next()
+	This member function returns the next pointer
+*/
+
+template <typename Type, int N>
+typename Unrolled_sentinel_list<Type, N>::Unrolled_node *Unrolled_sentinel_list<Type, N>::Unrolled_node::next() const {
+
+	return next_node;
+}
+
+#endif
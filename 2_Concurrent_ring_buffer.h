@@ -0,0 +1,582 @@
+#ifndef CONCURRENT_RING_BUFFER_H
+#define CONCURRENT_RING_BUFFER_H
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Spsc_ring_buffer<Type> and Mpmc_ring_buffer<Type>
+	Bounded lock-free queues for handing values from one pipeline thread to another,
+	with the circular array layout of Resizable_deque: the capacity is a power of two
+	(at least 16) and a position is found by masking a counter with capacity - 1.
+	Instead of front/back positions the queues keep two 64-bit counters that only grow
+	(the number of values ever pushed and popped), so full and empty are told apart
+	without a size member and the counters never wrap in practice.
+
+	Each counter is written by one side and read by the other, so each is kept on its own
+	cache line (RING_BUFFER_CACHE_LINE bytes) to avoid false sharing between producers and consumers.
+
+	The queues never grow: push() returns false when the queue is full and pop() returns
+	false when it is empty, since another thread may change the queue between a call to
+	size() and the push or pop. push_bulk() and pop_bulk() move as many values as possible
+	(up to n) with a single update of the shared counter, and return how many were moved.
+	size() is exact only when no other thread is using the queue.
+*/
+
+static std::size_t const RING_BUFFER_CACHE_LINE = 64;
+
+/* Spsc_ring_buffer<Type>
+	Queue for exactly one producer thread (push, push_bulk) and one consumer thread
+	(pop, pop_bulk). The producer publishes values with a release store of ring_tail and
+	the consumer frees slots with a release store of ring_head; each side reads the other
+	counter with an acquire load only when its cached copy says the queue is full (or empty).
+*/
+
+template <typename Type>
+class Spsc_ring_buffer {
+	public:
+
+		// Constructors
+
+		Spsc_ring_buffer( int = 1024 );
+		Spsc_ring_buffer( Spsc_ring_buffer const & ) = delete;
+		Spsc_ring_buffer &operator=( Spsc_ring_buffer const & ) = delete;
+		~Spsc_ring_buffer();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		// Mutators (producer)
+
+		bool push( Type const & );
+		bool push( Type && );
+		int push_bulk( Type const *, int );
+
+		// Mutators (consumer)
+
+		bool pop( Type & );
+		int pop_bulk( Type *, int );
+
+	private:
+		Type *ring_array;
+		std::uint64_t ring_mask;
+
+		// Written by the consumer
+		alignas( RING_BUFFER_CACHE_LINE ) std::atomic<std::uint64_t> ring_head;
+		std::uint64_t cached_tail;
+
+		// Written by the producer
+		alignas( RING_BUFFER_CACHE_LINE ) std::atomic<std::uint64_t> ring_tail;
+		std::uint64_t cached_head;
+
+		template <typename Arg>
+		bool push_value( Arg && );
+		int free_slots( std::uint64_t );
+		int used_slots( std::uint64_t );
+};
+
+/* Mpmc_ring_buffer<Type>
+	Queue for any number of producer and consumer threads (D. Vyukov's bounded MPMC queue).
+	Every cell has a sequence number saying whose turn it is: a cell at position p is free
+	for the push of counter value p when its sequence is p, and holds the value for the pop
+	of counter value p when its sequence is p + 1. A thread claims a counter value with a
+	compare-and-swap on ring_tail (push) or ring_head (pop), then builds or takes the value
+	and hands the cell on with a release store of its sequence. A bulk operation claims a
+	run of consecutive ready cells with a single compare-and-swap.
+
+	A claimed cell cannot be given back, and every later push or pop of that cell would wait
+	for its sequence forever, so building a value in a cell (copy or move construction) and
+	taking it out (move assignment) must not throw; each operation checks this at compile time.
+*/
+
+template <typename Type>
+class Mpmc_ring_buffer {
+	public:
+
+		// Constructors
+
+		Mpmc_ring_buffer( int = 1024 );
+		Mpmc_ring_buffer( Mpmc_ring_buffer const & ) = delete;
+		Mpmc_ring_buffer &operator=( Mpmc_ring_buffer const & ) = delete;
+		~Mpmc_ring_buffer();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		// Mutators
+
+		bool push( Type const & );
+		bool push( Type && );
+		int push_bulk( Type const *, int );
+
+		bool pop( Type & );
+		int pop_bulk( Type *, int );
+
+	private:
+		class Ring_cell {
+			public:
+				Type *value();
+
+				std::atomic<std::uint64_t> sequence;
+				alignas( Type ) unsigned char cell_storage[sizeof( Type )];
+		};
+
+		Ring_cell *ring_cells;
+		std::uint64_t ring_mask;
+
+		alignas( RING_BUFFER_CACHE_LINE ) std::atomic<std::uint64_t> ring_head;
+		alignas( RING_BUFFER_CACHE_LINE ) std::atomic<std::uint64_t> ring_tail;
+
+		template <typename Arg>
+		bool push_value( Arg && );
+		int claim( std::atomic<std::uint64_t> &, std::uint64_t &, int );
+};
+
+/* Helper: ring_buffer_capacity( int n )
+	This function returns the smallest power of two that is greater or equal to n and to 16,
+	the capacity rule of Resizable_deque.
+	An overflow error is thrown if that power of two does not fit in an int.
+*/
+
+inline int ring_buffer_capacity( int n ) {
+
+	if ( n > std::numeric_limits<int>::max()/2 + 1 ) throw overflow();
+
+	int capacity = 16;
+	while ( capacity < n ) capacity *= 2;
+	return capacity;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                          Spsc_ring_buffer                           //
+/////////////////////////////////////////////////////////////////////////
+
+/* Constructor: Spsc_ring_buffer( int n )
+	This constructor allocates uninitialized storage for n values (rounded up to a power of two)
+*/
+
+template <typename Type>
+Spsc_ring_buffer<Type>::Spsc_ring_buffer( int n ):
+ring_array( nullptr ),
+ring_mask( ring_buffer_capacity( n ) - 1 ),
+ring_head( 0 ),
+cached_tail( 0 ),
+ring_tail( 0 ),
+cached_head( 0 )
+{
+	ring_array = std::allocator<Type>().allocate( ring_mask + 1 );
+}
+
+/* Destructor: ~Spsc_ring_buffer()
+	It destroys the values left in the queue and releases the storage.
+	No other thread may be using the queue.
+*/
+
+template <typename Type>
+Spsc_ring_buffer<Type>::~Spsc_ring_buffer() {
+
+	for ( std::uint64_t i = ring_head.load(); i != ring_tail.load(); ++i ) {
+		ring_array[i & ring_mask].~Type();
+	}
+	std::allocator<Type>().deallocate( ring_array, ring_mask + 1 );
+}
+
+/* Accessor: size()
+	This function returns the number of values in the queue
+*/
+
+template <typename Type>
+int Spsc_ring_buffer<Type>::size() const {
+
+	return static_cast<int>( ring_tail.load( std::memory_order_acquire ) - ring_head.load( std::memory_order_acquire ) );
+}
+
+template <typename Type>
+bool Spsc_ring_buffer<Type>::empty() const {
+
+	return ( size() == 0 );
+}
+
+template <typename Type>
+int Spsc_ring_buffer<Type>::capacity() const {
+
+	return static_cast<int>( ring_mask + 1 );
+}
+
+/* Mutator: push( obj )
+	This mutator (producer only) inserts a copy of obj (or obj itself, moved) at the back
+	of the queue. It returns false, without inserting, if the queue is full.
+*/
+
+template <typename Type>
+bool Spsc_ring_buffer<Type>::push( Type const &obj ) {
+
+	return push_value( obj );
+}
+
+template <typename Type>
+bool Spsc_ring_buffer<Type>::push( Type &&obj ) {
+
+	return push_value( std::move( obj ) );
+}
+
+/* Mutator: push_bulk( values, n )
+	This mutator (producer only) inserts copies of values[0], ..., values[k - 1], where k is n
+	or the number of free slots if smaller, in at most two contiguous runs of the array, and
+	publishes them all with one store. It returns k.
+	If a copy throws, the values already copied are published and the exception is rethrown.
+*/
+
+template <typename Type>
+int Spsc_ring_buffer<Type>::push_bulk( Type const *values, int n ) {
+
+	if ( n <= 0 ) return 0;
+
+	std::uint64_t tail = ring_tail.load( std::memory_order_relaxed );
+	int count = std::min( n, free_slots( tail ) );
+
+	int i = 0;
+	try {
+		for ( ; i < count; ++i ) {
+			new ( ring_array + ( ( tail + i ) & ring_mask ) ) Type( values[i] );
+		}
+	}
+	catch ( ... ) {
+		ring_tail.store( tail + i, std::memory_order_release );
+		throw;
+	}
+
+	ring_tail.store( tail + count, std::memory_order_release );
+	return count;
+}
+
+/* Mutator: pop( obj )
+	This mutator (consumer only) moves the front value of the queue into obj and removes it.
+	It returns false, leaving obj unchanged, if the queue is empty.
+*/
+
+template <typename Type>
+bool Spsc_ring_buffer<Type>::pop( Type &obj ) {
+
+	std::uint64_t head = ring_head.load( std::memory_order_relaxed );
+	if ( used_slots( head ) == 0 ) return false;
+
+	Type &value = ring_array[head & ring_mask];
+	obj = std::move( value );
+	value.~Type();
+
+	ring_head.store( head + 1, std::memory_order_release );
+	return true;
+}
+
+/* Mutator: pop_bulk( values, n )
+	This mutator (consumer only) moves the k front values of the queue into values[0], ...,
+	values[k - 1], where k is n or the number of values in the queue if smaller, and frees
+	their slots with one store. It returns k.
+	If a move throws, the values already moved out are removed and the exception is rethrown.
+*/
+
+template <typename Type>
+int Spsc_ring_buffer<Type>::pop_bulk( Type *values, int n ) {
+
+	if ( n <= 0 ) return 0;
+
+	std::uint64_t head = ring_head.load( std::memory_order_relaxed );
+	int count = std::min( n, used_slots( head ) );
+
+	int i = 0;
+	try {
+		for ( ; i < count; ++i ) {
+			Type &value = ring_array[( head + i ) & ring_mask];
+			values[i] = std::move( value );
+			value.~Type();
+		}
+	}
+	catch ( ... ) {
+		ring_head.store( head + i, std::memory_order_release );
+		throw;
+	}
+
+	ring_head.store( head + count, std::memory_order_release );
+	return count;
+}
+
+/* Private member function: push_value( obj )
+	This function implements both push() overloads
+*/
+
+template <typename Type>
+template <typename Arg>
+bool Spsc_ring_buffer<Type>::push_value( Arg &&obj ) {
+
+	std::uint64_t tail = ring_tail.load( std::memory_order_relaxed );
+	if ( free_slots( tail ) == 0 ) return false;
+
+	new ( ring_array + ( tail & ring_mask ) ) Type( std::forward<Arg>( obj ) );
+
+	ring_tail.store( tail + 1, std::memory_order_release );
+	return true;
+}
+
+/* Private member function: free_slots( tail )
+	This function (producer only) returns the number of free slots. The consumer's counter
+	is only read again when the cached copy says the queue is full.
+*/
+
+template <typename Type>
+int Spsc_ring_buffer<Type>::free_slots( std::uint64_t tail ) {
+
+	std::uint64_t capacity = ring_mask + 1;
+
+	if ( tail - cached_head == capacity ) {
+		cached_head = ring_head.load( std::memory_order_acquire );
+	}
+
+	return static_cast<int>( capacity - ( tail - cached_head ) );
+}
+
+/* Private member function: used_slots( head )
+	This function (consumer only) returns the number of values in the queue. The producer's
+	counter is only read again when the cached copy says the queue is empty.
+*/
+
+template <typename Type>
+int Spsc_ring_buffer<Type>::used_slots( std::uint64_t head ) {
+
+	if ( cached_tail == head ) {
+		cached_tail = ring_tail.load( std::memory_order_acquire );
+	}
+
+	return static_cast<int>( cached_tail - head );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                          Mpmc_ring_buffer                           //
+/////////////////////////////////////////////////////////////////////////
+
+/* Constructor: Mpmc_ring_buffer( int n )
+	This constructor allocates n cells (rounded up to a power of two); cell i is free for
+	the push of counter value i
+*/
+
+template <typename Type>
+Mpmc_ring_buffer<Type>::Mpmc_ring_buffer( int n ):
+ring_cells( nullptr ),
+ring_mask( ring_buffer_capacity( n ) - 1 ),
+ring_head( 0 ),
+ring_tail( 0 )
+{
+	ring_cells = new Ring_cell[ring_mask + 1];
+	for ( std::uint64_t i = 0; i <= ring_mask; ++i ) {
+		ring_cells[i].sequence.store( i, std::memory_order_relaxed );
+	}
+}
+
+/* Destructor: ~Mpmc_ring_buffer()
+	It destroys the values left in the queue and releases the cells.
+	No other thread may be using the queue.
+*/
+
+template <typename Type>
+Mpmc_ring_buffer<Type>::~Mpmc_ring_buffer() {
+
+	for ( std::uint64_t i = ring_head.load(); i != ring_tail.load(); ++i ) {
+		ring_cells[i & ring_mask].value()->~Type();
+	}
+	delete [] ring_cells;
+}
+
+template <typename Type>
+int Mpmc_ring_buffer<Type>::size() const {
+
+	std::uint64_t head = ring_head.load( std::memory_order_acquire );
+	std::uint64_t tail = ring_tail.load( std::memory_order_acquire );
+	return ( tail > head ) ? static_cast<int>( tail - head ) : 0;
+}
+
+template <typename Type>
+bool Mpmc_ring_buffer<Type>::empty() const {
+
+	return ( size() == 0 );
+}
+
+template <typename Type>
+int Mpmc_ring_buffer<Type>::capacity() const {
+
+	return static_cast<int>( ring_mask + 1 );
+}
+
+/* Mutator: push( obj )
+	This mutator inserts a copy of obj (or obj itself, moved) at the back of the queue.
+	It returns false, without inserting, if the queue is full.
+*/
+
+template <typename Type>
+bool Mpmc_ring_buffer<Type>::push( Type const &obj ) {
+
+	return push_value( obj );
+}
+
+template <typename Type>
+bool Mpmc_ring_buffer<Type>::push( Type &&obj ) {
+
+	return push_value( std::move( obj ) );
+}
+
+/* Mutator: push_bulk( values, n )
+	This mutator claims up to n consecutive free cells with one compare-and-swap, copies
+	values[0], ..., values[k - 1] into them and returns k (0 if the queue is full).
+*/
+
+template <typename Type>
+int Mpmc_ring_buffer<Type>::push_bulk( Type const *values, int n ) {
+
+	static_assert( std::is_nothrow_copy_constructible<Type>::value,
+	               "Mpmc_ring_buffer::push_bulk() requires a copy constructor that does not throw" );
+
+	if ( n <= 0 ) return 0;
+
+	std::uint64_t tail = ring_tail.load( std::memory_order_relaxed );
+	int count = 0;
+
+	while ( true ) {
+		count = claim( ring_tail, tail, n );
+		if ( count == 0 ) return 0;
+		if ( ring_tail.compare_exchange_weak( tail, tail + count, std::memory_order_relaxed ) ) break;
+	}
+
+	for ( int i = 0; i < count; ++i ) {
+		Ring_cell &cell = ring_cells[( tail + i ) & ring_mask];
+		new ( cell.value() ) Type( values[i] );
+		cell.sequence.store( tail + i + 1, std::memory_order_release );
+	}
+
+	return count;
+}
+
+/* Mutator: pop( obj )
+	This mutator moves the front value of the queue into obj and removes it.
+	It returns false, leaving obj unchanged, if the queue is empty.
+*/
+
+template <typename Type>
+bool Mpmc_ring_buffer<Type>::pop( Type &obj ) {
+
+	return ( pop_bulk( &obj, 1 ) == 1 );
+}
+
+/* Mutator: pop_bulk( values, n )
+	This mutator claims up to n consecutive cells holding values with one compare-and-swap,
+	moves their values into values[0], ..., values[k - 1] and returns k (0 if the queue is empty).
+*/
+
+template <typename Type>
+int Mpmc_ring_buffer<Type>::pop_bulk( Type *values, int n ) {
+
+	static_assert( std::is_nothrow_move_assignable<Type>::value,
+	               "Mpmc_ring_buffer::pop() and pop_bulk() require a move assignment that does not throw" );
+
+	if ( n <= 0 ) return 0;
+
+	std::uint64_t head = ring_head.load( std::memory_order_relaxed );
+	int count = 0;
+
+	while ( true ) {
+		count = claim( ring_head, head, n );
+		if ( count == 0 ) return 0;
+		if ( ring_head.compare_exchange_weak( head, head + count, std::memory_order_relaxed ) ) break;
+	}
+
+	for ( int i = 0; i < count; ++i ) {
+		Ring_cell &cell = ring_cells[( head + i ) & ring_mask];
+		values[i] = std::move( *cell.value() );
+		cell.value()->~Type();
+		cell.sequence.store( head + i + ring_mask + 1, std::memory_order_release );
+	}
+
+	return count;
+}
+
+/* Private member function: push_value( obj )
+	This function implements both push() overloads
+*/
+
+template <typename Type>
+template <typename Arg>
+bool Mpmc_ring_buffer<Type>::push_value( Arg &&obj ) {
+
+	static_assert( std::is_nothrow_constructible<Type, Arg &&>::value,
+	               "Mpmc_ring_buffer::push() requires a copy (or move) constructor that does not throw" );
+
+	std::uint64_t tail = ring_tail.load( std::memory_order_relaxed );
+
+	while ( true ) {
+		if ( claim( ring_tail, tail, 1 ) == 0 ) return false;
+		if ( ring_tail.compare_exchange_weak( tail, tail + 1, std::memory_order_relaxed ) ) break;
+	}
+
+	Ring_cell &cell = ring_cells[tail & ring_mask];
+	new ( cell.value() ) Type( std::forward<Arg>( obj ) );
+	cell.sequence.store( tail + 1, std::memory_order_release );
+	return true;
+}
+
+/* Private member function: claim( counter, position, n )
+	This function counts how many of the (up to n) cells starting at the given counter
+	value are ready: free for a push (counter is ring_tail, sequence == position) or
+	holding a value for a pop (counter is ring_head, sequence == position + 1).
+	If the first cell is not ready because another thread has already claimed it,
+	position is reloaded from counter and the cells are counted again; 0 is returned only
+	when the queue is full (push) or empty (pop).
+	A cell that is seen ready stays ready until some thread claims it, so the caller may
+	claim the counted cells with a compare-and-swap from position.
+*/
+
+template <typename Type>
+int Mpmc_ring_buffer<Type>::claim( std::atomic<std::uint64_t> &counter, std::uint64_t &position, int n ) {
+
+	std::uint64_t ready = ( &counter == &ring_tail ) ? 0 : 1;
+
+	while ( true ) {
+		std::uint64_t sequence = ring_cells[position & ring_mask].sequence.load( std::memory_order_acquire );
+		std::int64_t difference = static_cast<std::int64_t>( sequence - ( position + ready ) );
+
+		if ( difference < 0 ) return 0;
+		if ( difference > 0 ) {
+			position = counter.load( std::memory_order_relaxed );
+			continue;
+		}
+
+		int count = 1;
+		while ( count < n and count <= static_cast<int>( ring_mask ) and
+		        ring_cells[( position + count ) & ring_mask].sequence.load( std::memory_order_acquire ) == position + count + ready ) {
+			++count;
+		}
+		return count;
+	}
+}
+
+/* Helper: value()
+	This function returns the address of the value stored in the cell
+*/
+
+template <typename Type>
+Type *Mpmc_ring_buffer<Type>::Ring_cell::value() {
+
+	return std::launder( reinterpret_cast<Type *>( cell_storage ) );
+}
+
+#endif
@@ -0,0 +1,216 @@
+// Throughput and latency benchmark of Spsc_ring_buffer and Mpmc_ring_buffer against
+// Resizable_deque behind a std::mutex (the hand-off queue they replace), at 1 to 64 threads.
+//
+// Build:	g++ -std=c++17 -O2 -pthread 2_Concurrent_ring_buffer_benchmark.cpp -o ring_benchmark
+// Run:		./ring_benchmark [values per producer (default 1000000)] [maximum threads (default 64)]
+//
+// With T threads, T/2 producers push their time stamps and T/2 consumers pop them (with one
+// thread, the same thread pushes and pops). Each run is made with push/pop of one value and
+// with push_bulk/pop_bulk of 32 values. The throughput is the number of values handed over
+// per second; the latency of a value is the time from its push to its pop, and the median,
+// 99th and 99.9th percentiles are printed (in nanoseconds). The single producer queue is
+// only run with two threads.
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The exceptions thrown by the queues
+class underflow {};
+class overflow {};
+class illegal_argument {};
+
+#include "2_Resizable_deque.h"
+#include "2_Concurrent_ring_buffer.h"
+
+/*
+	Locked_deque is the baseline: a Resizable_deque protected by a mutex, with the
+	push/pop interface of the ring buffers (the deque is unbounded, so push never fails)
+*/
+class Locked_deque {
+	public:
+		bool push( std::uint64_t value ) {
+			std::lock_guard<std::mutex> lock( deque_mutex );
+			deque.push_back( value );
+			return true;
+		}
+
+		bool pop( std::uint64_t &value ) {
+			std::lock_guard<std::mutex> lock( deque_mutex );
+			if ( deque.empty() ) return false;
+			value = deque.front();
+			deque.pop_front();
+			return true;
+		}
+
+		int push_bulk( std::uint64_t const *values, int n ) {
+			std::lock_guard<std::mutex> lock( deque_mutex );
+			deque.push_back_range( values, values + n );
+			return n;
+		}
+
+		int pop_bulk( std::uint64_t *values, int n ) {
+			std::lock_guard<std::mutex> lock( deque_mutex );
+			return deque.pop_front_n( values, n );
+		}
+
+	private:
+		Resizable_deque<std::uint64_t> deque;
+		std::mutex deque_mutex;
+};
+
+class Result {
+	public:
+		double values_per_second;
+		std::uint64_t median;
+		std::uint64_t p99;
+		std::uint64_t p999;
+};
+
+static std::uint64_t now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static int const SAMPLE_EVERY = 16;
+
+/*
+	produce pushes count time stamps, batch values at a time (yielding while the queue is full)
+*/
+template <typename Queue>
+void produce( Queue &queue, long count, int batch ) {
+	std::uint64_t values[64];
+
+	for ( long pushed = 0; pushed < count; ) {
+		int n = static_cast<int>( std::min<long>( batch, count - pushed ) );
+		std::uint64_t stamp = now();
+		for ( int i = 0; i < n; ++i ) values[i] = stamp;
+
+		int done = 0;
+		while ( done < n ) {
+			int k = ( batch == 1 ) ? ( queue.push( values[0] ) ? 1 : 0 ) : queue.push_bulk( values + done, n - done );
+			if ( k == 0 ) std::this_thread::yield();
+			done += k;
+		}
+		pushed += n;
+	}
+}
+
+/*
+	consume pops values until total values have been popped by all the consumers, and keeps
+	the latency of one value in SAMPLE_EVERY
+*/
+template <typename Queue>
+void consume( Queue &queue, std::atomic<long> &popped, long total, int batch, std::vector<std::uint64_t> &latencies ) {
+	std::uint64_t values[64];
+	long seen = 0;
+
+	while ( popped.load( std::memory_order_relaxed ) < total ) {
+		int k = ( batch == 1 ) ? ( queue.pop( values[0] ) ? 1 : 0 ) : queue.pop_bulk( values, batch );
+		if ( k == 0 ) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::uint64_t stamp = now();
+		for ( int i = 0; i < k; ++i, ++seen ) {
+			if ( seen % SAMPLE_EVERY == 0 ) latencies.push_back( stamp - values[i] );
+		}
+		popped.fetch_add( k, std::memory_order_relaxed );
+	}
+}
+
+/*
+	run hands count values per producer over queue with the given number of threads
+*/
+template <typename Queue>
+Result run( Queue &queue, int threads, long count, int batch ) {
+	int producers = std::max( 1, threads/2 );
+	int consumers = std::max( 1, threads - producers );
+	long total = producers*count;
+
+	std::vector<std::vector<std::uint64_t>> latencies( consumers );
+	std::atomic<long> popped( 0 );
+	std::uint64_t start = now();
+
+	if ( threads == 1 ) {
+		std::uint64_t values[64];
+		for ( long done = 0; done < total; ) {
+			int n = static_cast<int>( std::min<long>( batch, total - done ) );
+			std::uint64_t stamp = now();
+			for ( int i = 0; i < n; ++i ) values[i] = stamp;
+			int k = ( batch == 1 ) ? ( queue.push( values[0] ) ? 1 : 0 ) : queue.push_bulk( values, n );
+			k = ( batch == 1 ) ? ( queue.pop( values[0] ) ? 1 : 0 ) : queue.pop_bulk( values, k );
+			latencies[0].push_back( now() - values[0] );
+			done += k;
+		}
+	}
+	else {
+		std::vector<std::thread> pool;
+		for ( int i = 0; i < consumers; ++i ) {
+			pool.emplace_back( [&, i]{ consume( queue, popped, total, batch, latencies[i] ); } );
+		}
+		for ( int i = 0; i < producers; ++i ) {
+			pool.emplace_back( [&]{ produce( queue, count, batch ); } );
+		}
+		for ( auto &thread: pool ) thread.join();
+	}
+
+	double seconds = ( now() - start )*1e-9;
+
+	std::vector<std::uint64_t> all;
+	for ( auto const &sample: latencies ) all.insert( all.end(), sample.begin(), sample.end() );
+	std::sort( all.begin(), all.end() );
+
+	Result result;
+	result.values_per_second = total/seconds;
+	result.median = all.empty() ? 0 : all[all.size()/2];
+	result.p99 = all.empty() ? 0 : all[all.size()*99/100];
+	result.p999 = all.empty() ? 0 : all[all.size()*999/1000];
+	return result;
+}
+
+static void print( std::string const &name, int threads, int batch, Result const &result ) {
+	std::cout << std::left << std::setw( 12 ) << name << std::right
+	          << std::setw( 8 ) << threads << std::setw( 7 ) << batch
+	          << std::setw( 14 ) << std::fixed << std::setprecision( 2 ) << result.values_per_second/1e6
+	          << std::setw( 12 ) << result.median
+	          << std::setw( 12 ) << result.p99
+	          << std::setw( 12 ) << result.p999 << std::endl;
+}
+
+int main( int argc, char **argv ) {
+	long count = ( argc > 1 ) ? std::atol( argv[1] ) : 1000000;
+	int max_threads = ( argc > 2 ) ? std::atoi( argv[2] ) : 64;
+
+	std::cout << std::left << std::setw( 12 ) << "queue" << std::right
+	          << std::setw( 8 ) << "threads" << std::setw( 7 ) << "batch"
+	          << std::setw( 14 ) << "Mvalues/s" << std::setw( 12 ) << "p50 ns"
+	          << std::setw( 12 ) << "p99 ns" << std::setw( 12 ) << "p99.9 ns" << std::endl;
+
+	for ( int threads = 1; threads <= max_threads; threads *= 2 ) {
+		for ( int batch: { 1, 32 } ) {
+			{
+				Locked_deque queue;
+				print( "mutex deque", threads, batch, run( queue, threads, count, batch ) );
+			}
+			if ( threads == 2 ) {
+				Spsc_ring_buffer<std::uint64_t> queue( 1024 );
+				print( "spsc ring", threads, batch, run( queue, threads, count, batch ) );
+			}
+			{
+				Mpmc_ring_buffer<std::uint64_t> queue( 1024 );
+				print( "mpmc ring", threads, batch, run( queue, threads, count, batch ) );
+			}
+		}
+	}
+
+	return 0;
+}
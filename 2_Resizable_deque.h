@@ -1,12 +1,223 @@
+#ifndef RESIZABLE_DEQUE_H
+#define RESIZABLE_DEQUE_H
+
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __cpp_lib_span ) || ( __cplusplus >= 202002L && defined( __has_include ) && __has_include( <span> ) )
+#include <span>
+#define RESIZABLE_DEQUE_STD_SPAN 1
+#endif
+
+/* Storage modes of Resizable_deque
+	Ring_buffer_mode	-> (default) the elements are stored in one circular array whose
+						   capacity is a power of two. Growing relocates every element.
+	Block_map_mode<N>	-> the elements are stored in blocks of N elements, found through a
+						   small circular map of block addresses (as std::deque does).
+						   Growing allocates one block (and, rarely, copies the map of
+						   addresses), so elements never move and their addresses are stable.
+	Inline_buffer_mode<N>	-> a ring buffer whose first N elements (N a power of two) are stored
+						   in the deque object itself: a deque that never holds more than N
+						   elements never allocates. It moves to a heap array when it grows
+						   past N, and back into the object when it shrinks to N.
+	All modes share the deque interface (constructors, front/back, push and pop at both ends,
+	the range pushes and pops, operator[], iterators, reserve, shrink_to_fit, swap, is_inline):
+		Resizable_deque<int, Block_map_mode<256>> d;
+	The ring buffer modes also have as_spans(), consume(), writable_spans() and commit(),
+	which hand out the elements as at most two contiguous runs of the array. Block_map_mode
+	does not, since its elements are split over one run per block.
+*/
+
+struct Ring_buffer_mode {};
+
+template <int N = 64>
+struct Block_map_mode {};
+
+template <int N = 8>
+struct Inline_buffer_mode {};
+
+/* Deque_inline_capacity<Mode>
+	The number of elements stored in the object in a ring buffer mode: 0 for Ring_buffer_mode
+	and N for Inline_buffer_mode<N>. Deque_inline_storage<Type, N> is that storage (nothing
+	for N = 0); the deque inherits it, so Ring_buffer_mode pays no space for it.
+*/
+
+template <typename Mode>
+struct Deque_inline_capacity;
+
+template <>
+struct Deque_inline_capacity<Ring_buffer_mode> {
+	static constexpr int value = 0;
+};
+
+template <int N>
+struct Deque_inline_capacity<Inline_buffer_mode<N>> {
+	static_assert( N > 0 and ( N & ( N - 1 ) ) == 0, "Inline_buffer_mode<N> needs a power of two" );
+	static constexpr int value = N;
+};
+
+template <typename Type, int N>
+class Deque_inline_storage {
+	protected:
+		Type *inline_array() { return reinterpret_cast<Type *>( inline_storage ); }
+		Type const *inline_array() const { return reinterpret_cast<Type const *>( inline_storage ); }
+
+	private:
+		alignas( Type ) unsigned char inline_storage[N*sizeof( Type )];
+};
+
+template <typename Type>
+class Deque_inline_storage<Type, 0> {
+	protected:
+		Type *inline_array() { return nullptr; }
+		Type const *inline_array() const { return nullptr; }
+};
+
+/* Growth policy: Growth_policy<Factor, Shrink_divisor, Minimum, Shrink>
+	This is the third template parameter of Resizable_deque. In ring buffer mode:
+	- A full array grows to Factor times its capacity (Factor must be a power of two).
+	- After a pop, if the number of elements is capacity/Shrink_divisor or less, the
+	  capacity is divided by Factor. Shrink_divisor must be greater than Factor, so a
+	  deque that has just shrunk is never full, and a workload oscillating around a
+	  boundary does not reallocate on every push and pop (hysteresis).
+	- The capacity never shrinks below Minimum (nor below the initial capacity).
+	- If Shrink is false the capacity never shrinks automatically (only shrink_to_fit()).
+	In block map mode the elements are never relocated; Factor is used to grow the map
+	of block addresses, and the other parameters do not apply.
+	Example: Resizable_deque<int, Ring_buffer_mode, Growth_policy<4, 16, 1024>> d;
+*/
+
+template <int Factor = 2, int Shrink_divisor = 4, int Minimum = 16, bool Shrink = true>
+struct Growth_policy {
+	static_assert( Factor >= 2 and ( Factor & ( Factor - 1 ) ) == 0, "The growth factor must be a power of two" );
+	static_assert( Shrink_divisor > Factor, "The shrink divisor must be greater than the growth factor" );
+	static_assert( Minimum >= 1, "The minimum capacity must be positive" );
 
+	static constexpr int factor = Factor;
+	static constexpr int shrink_divisor = Shrink_divisor;
+	static constexpr int minimum_capacity = Minimum;
+	static constexpr bool shrink = Shrink;
+};
+
+typedef Growth_policy<> Doubling_growth;
+typedef Growth_policy<2, 4, 16, false> Never_shrink_growth;
+
+template <typename Type, typename Mode = Ring_buffer_mode, typename Growth = Doubling_growth>
+class Resizable_deque;
+
+template <typename Type, int N = 8, typename Growth = Doubling_growth>
+using Inline_deque = Resizable_deque<Type, Inline_buffer_mode<N>, Growth>;
+
+/* Deque_span<Type>
+	A contiguous run of elements of a Resizable_deque, returned by as_spans() and
+	writable_spans(). It is std::span<Type> when the standard library has it (C++20), and
+	otherwise a minimal pointer and size with the same data(), size(), begin() and end().
+	For I/O: struct iovec io = { span.data(), span.size()*sizeof( Type ) };
+*/
+
+#ifdef RESIZABLE_DEQUE_STD_SPAN
+template <typename Type>
+using Deque_span = std::span<Type>;
+#else
 template <typename Type>
-class Resizable_deque {
+class Deque_span {
 	public:
+		Deque_span( Type *data = nullptr, std::size_t size = 0 ): span_data( data ), span_size( size ) {}
+
+		Type *data() const { return span_data; }
+		std::size_t size() const { return span_size; }
+		std::size_t size_bytes() const { return span_size*sizeof( Type ); }
+		bool empty() const { return span_size == 0; }
+		Type *begin() const { return span_data; }
+		Type *end() const { return span_data + span_size; }
+		Type &operator[]( std::size_t i ) const { return span_data[i]; }
+
+	private:
+		Type *span_data;
+		std::size_t span_size;
+};
+#endif
+
+/* Resizable_deque_iterator<Deque, Value>
+	Random access iterator of Resizable_deque (in either mode): iterator is
+	Resizable_deque_iterator<Resizable_deque, Type> and const_iterator is
+	Resizable_deque_iterator<Resizable_deque const, Type const>.
+	It holds the deque and the index of the element counted from the front, and is
+	dereferenced with the deque's operator[]. Any push or pop invalidates it.
+*/
+
+template <typename Deque, typename Value>
+class Resizable_deque_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef typename std::remove_const<Value>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Value *pointer;
+		typedef Value &reference;
+
+		Resizable_deque_iterator( Deque *deque = nullptr, int index = 0 ): iterator_deque( deque ), iterator_index( index ) {}
+
+		// An iterator converts to a const_iterator
+		template <typename Other_deque, typename Other_value>
+		Resizable_deque_iterator( Resizable_deque_iterator<Other_deque, Other_value> const &other ):
+		iterator_deque( other.iterator_deque ), iterator_index( other.iterator_index ) {}
+
+		reference operator*() const { return ( *iterator_deque )[iterator_index]; }
+		pointer operator->() const { return &( *iterator_deque )[iterator_index]; }
+		reference operator[]( difference_type n ) const { return ( *iterator_deque )[iterator_index + n]; }
+
+		Resizable_deque_iterator &operator++() { ++iterator_index; return *this; }
+		Resizable_deque_iterator &operator--() { --iterator_index; return *this; }
+		Resizable_deque_iterator operator++( int ) { Resizable_deque_iterator old( *this ); ++iterator_index; return old; }
+		Resizable_deque_iterator operator--( int ) { Resizable_deque_iterator old( *this ); --iterator_index; return old; }
+		Resizable_deque_iterator &operator+=( difference_type n ) { iterator_index += n; return *this; }
+		Resizable_deque_iterator &operator-=( difference_type n ) { iterator_index -= n; return *this; }
+		Resizable_deque_iterator operator+( difference_type n ) const { return Resizable_deque_iterator( iterator_deque, iterator_index + n ); }
+		Resizable_deque_iterator operator-( difference_type n ) const { return Resizable_deque_iterator( iterator_deque, iterator_index - n ); }
+		friend Resizable_deque_iterator operator+( difference_type n, Resizable_deque_iterator const &it ) { return it + n; }
+		difference_type operator-( Resizable_deque_iterator const &rhs ) const { return iterator_index - rhs.iterator_index; }
+
+		bool operator==( Resizable_deque_iterator const &rhs ) const { return iterator_index == rhs.iterator_index; }
+		bool operator!=( Resizable_deque_iterator const &rhs ) const { return iterator_index != rhs.iterator_index; }
+		bool operator<( Resizable_deque_iterator const &rhs ) const { return iterator_index < rhs.iterator_index; }
+		bool operator>( Resizable_deque_iterator const &rhs ) const { return iterator_index > rhs.iterator_index; }
+		bool operator<=( Resizable_deque_iterator const &rhs ) const { return iterator_index <= rhs.iterator_index; }
+		bool operator>=( Resizable_deque_iterator const &rhs ) const { return iterator_index >= rhs.iterator_index; }
+
+	private:
+		Deque *iterator_deque;
+		int iterator_index;
+
+		template <typename, typename>
+		friend class Resizable_deque_iterator;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                 Ring buffer and inline buffer modes                 //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, typename Mode, typename Growth>
+class Resizable_deque : private Deque_inline_storage<Type, Deque_inline_capacity<Mode>::value> {
+	static constexpr int inline_capacity = Deque_inline_capacity<Mode>::value;
+
+	public:
+		typedef Resizable_deque_iterator<Resizable_deque, Type> iterator;
+		typedef Resizable_deque_iterator<Resizable_deque const, Type const> const_iterator;
 
 		// Constructors
 
-		Resizable_deque( int = 16 );
+		Resizable_deque( int = 0 );
 		Resizable_deque( Resizable_deque const & );
 		Resizable_deque( Resizable_deque && );
 		~Resizable_deque();
@@ -18,6 +229,16 @@ class Resizable_deque {
 		int size() const;
 		bool empty() const;
 		int capacity() const;
+		bool is_inline() const;
+		int reallocations() const;
+		long long bytes_copied() const;
+		Type &operator[]( int );
+		Type const &operator[]( int ) const;
+		iterator begin();
+		iterator end();
+		const_iterator begin() const;
+		const_iterator end() const;
+		std::array<Deque_span<Type const>, 2> as_spans() const;
 
 		// Mutators
 
@@ -29,6 +250,19 @@ class Resizable_deque {
 		void pop_front();
 		void pop_back();
 		void clear();
+		void reserve( int );
+		void shrink_to_fit();
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator );
+		template <typename Iterator>
+		void push_front_range( Iterator, Iterator );
+		template <typename Iterator>
+		int pop_front_n( Iterator, int );
+		template <typename Iterator>
+		int pop_back_n( Iterator, int );
+		void consume( int );
+		std::array<Deque_span<Type>, 2> writable_spans( int = 0 );
+		void commit( int );
 		//void print(); // Function used to print the deque
 
 	private:
@@ -38,9 +272,26 @@ class Resizable_deque {
 		int deque_front;
 		int deque_back;
 		Type *deque_array;
+		int deque_reallocations;
+		long long deque_bytes_copied;
 		// Any private member functions
 		//   - helper function for resizing the array
-		void resize();
+		void resize( int );
+		void relocate_to( Type *, int );
+		void grow();
+		void shrink();
+		void reserve_for( int );
+		void relocate( Type * );
+		template <typename Iterator>
+		void construct_range( int, Iterator, int );
+		template <typename Iterator>
+		void move_out_range( int, Iterator, int );
+		void destroy_range( int, int );
+		void destroy_all();
+		int index_of( Type const * ) const;
+		static int round_capacity( int );
+		Type *allocate( int );
+		void deallocate( Type *, int );
 
 };
 
@@ -53,53 +304,109 @@ class Resizable_deque {
 	This is the (non-) default constructor that allocates the memory for an array 
 	with the initial capacity of n. The initial capacity (n) must be greater or 
 	equal to 16. If n < 16, the initial capacity is set to 16.
+	The capacity is always a power of two, so n is rounded up to the next power of two
+	and a position in the array is computed with a mask (& (capacity - 1)) instead of %.
 
 	deque_size 				-> Number of elements in the array
 	deque_front 			-> Position of the front element of the array
-	deque_back 				-> Position of the back element of the array
+	deque_back 				-> Position after the back element of the array
 	deque_initial_capacity 	-> Initial capacity of the array
 	deque_capacity 			-> Actual capacity of the array
-	deque_array 			-> Empty array initialized with the initial capacity
+	deque_array 			-> Uninitialized storage for the initial capacity
 
 	This constructor assumes the initial capacity to be greater or equal to 16.
+	The initial capacity is also at least the minimum capacity of the growth policy.
+	In Inline_buffer_mode<N>, an initial capacity of N or less is the inline array of N
+	elements, so no memory is allocated (this is the default).
 	The front and back is set to 0, so they point to the same element. The size 
 	is set to 0, i.e. the array is empty.
 	No errors are expected with this constructor
 */
-template <typename Type>
-Resizable_deque<Type>::Resizable_deque( int n )
+template <typename Type, typename Mode, typename Growth>
+Resizable_deque<Type, Mode, Growth>::Resizable_deque( int n )
 :deque_size(0), 
 deque_front(0),
-deque_back(0)
+deque_back(0),
+deque_reallocations(0),
+deque_bytes_copied(0)
 {
 	// Check the initial capacity of the array
-	int capacity = ( n < 16 ) ? 16: n;
+	int capacity = ( inline_capacity > 0 && n <= inline_capacity ) ? inline_capacity
+	             : round_capacity( ( n < Growth::minimum_capacity ) ? Growth::minimum_capacity : n );
 	deque_initial_capacity = capacity;
 	deque_capacity = capacity;
-	deque_array = new Type[deque_capacity];
+	deque_array = allocate(deque_capacity);
 }
 
-// Copy Constructor
-template <typename Type>
-Resizable_deque<Type>::Resizable_deque( Resizable_deque const &deque )
-{ }
+/* Copy Constructor: Resizable_deque( deque )
+	This constructor allocates an array for size() elements (rounded up to a legal capacity,
+	as for Resizable_deque( size() )), and copies the elements of deque, which are in at most
+	two contiguous runs of its array, to the start of it: with one memcpy per run for
+	trivially copyable types. The initial capacity is at most that of deque, so the copy
+	shrinks as deque would.
+	If a copy throws, the delegated constructor has completed, so the destructor
+	releases what was copied so far.
+*/
 
-// Move Constructor
-template <typename Type>
-Resizable_deque<Type>::Resizable_deque( Resizable_deque &&deque )
-{ }
+template <typename Type, typename Mode, typename Growth>
+Resizable_deque<Type, Mode, Growth>::Resizable_deque( Resizable_deque const &deque )
+:Resizable_deque(deque.deque_size)
+{
+	deque_initial_capacity = std::min(deque_initial_capacity, deque.deque_initial_capacity);
+
+	std::array<Deque_span<Type const>, 2> runs = deque.as_spans();
+	int first = static_cast<int>(runs[0].size());
+	construct_range(0, runs[0].data(), first);
+	deque_size = first;
+	construct_range(first, runs[1].data(), deque.deque_size - first);
+	deque_size = deque.deque_size;
+	deque_back = deque_size & (deque_capacity - 1);
+}
+
+/* Move Constructor: Resizable_deque( deque )
+	This constructor takes the array of deque in O(1), without allocating; if the elements of
+	deque are in its inline array (Inline_buffer_mode<N>), they are moved to the inline array
+	of *this instead. deque is left empty with its inline array, or with no array at all
+	(capacity 0) in Ring_buffer_mode; the next push allocates one of its initial capacity.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+Resizable_deque<Type, Mode, Growth>::Resizable_deque( Resizable_deque &&deque )
+:deque_reallocations(deque.deque_reallocations),
+deque_bytes_copied(deque.deque_bytes_copied)
+{
+	if (deque.is_inline())
+		deque.relocate_to(this->inline_array(), inline_capacity);
+
+	deque_capacity = deque.deque_capacity;
+	deque_initial_capacity = deque.deque_initial_capacity;
+	deque_size = deque.deque_size;
+	deque_front = deque.deque_front;
+	deque_back = deque.deque_back;
+	deque_array = deque.deque_array;
+
+	deque.deque_array = deque.inline_array();
+	deque.deque_capacity = inline_capacity;
+	deque.deque_size = 0;
+	deque.deque_front = 0;
+	deque.deque_back = 0;
+	deque.deque_reallocations = 0;
+	deque.deque_bytes_copied = 0;
+}
 
 /* Destructor: ~Resizable_deque()
-	This is the destructor that deallocates any dynamically allocated memory.
+	This is the destructor that destroys the elements in the deque and
+	deallocates any dynamically allocated memory.
 
 	deque_array 	-> dinamically allocated array
 
 	No errors are expected with this destructor
 */
-template <typename Type>
-Resizable_deque<Type>::~Resizable_deque() {
+template <typename Type, typename Mode, typename Growth>
+Resizable_deque<Type, Mode, Growth>::~Resizable_deque() {
 
-	delete [] deque_array;
+	destroy_all();
+	deallocate(deque_array, deque_capacity);
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -113,8 +420,8 @@ Resizable_deque<Type>::~Resizable_deque() {
 	No errors are expected with this accessor
 */
 
-template <typename Type>
-int Resizable_deque<Type>::size() const {
+template <typename Type, typename Mode, typename Growth>
+int Resizable_deque<Type, Mode, Growth>::size() const {
 
 	return deque_size;
 }
@@ -126,11 +433,95 @@ int Resizable_deque<Type>::size() const {
 	No errors are expected with this accessor
 */
 
-template <typename Type>
-int Resizable_deque<Type>::capacity() const {
+template <typename Type, typename Mode, typename Growth>
+int Resizable_deque<Type, Mode, Growth>::capacity() const {
 	return deque_capacity;
 }
 
+/* Accessor: is_inline()
+	This function returns true if the elements are stored in the deque object itself
+	(Inline_buffer_mode<N> with a capacity of N), and false if they are in a heap array.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+bool Resizable_deque<Type, Mode, Growth>::is_inline() const {
+	return inline_capacity > 0 && deque_array == this->inline_array();
+}
+
+/* Accessor: reallocations()
+	This function returns the number of times the array has been reallocated
+	(grown, shrunk, reserved or shrunk to fit) since the deque was created.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+int Resizable_deque<Type, Mode, Growth>::reallocations() const {
+	return deque_reallocations;
+}
+
+/* Accessor: bytes_copied()
+	This function returns the number of bytes of elements relocated by those reallocations
+*/
+
+template <typename Type, typename Mode, typename Growth>
+long long Resizable_deque<Type, Mode, Growth>::bytes_copied() const {
+	return deque_bytes_copied;
+}
+
+/* Accessor: operator[]( int i )
+	This function returns a reference to element i, counted from the front (0 <= i < size()).
+	The index is not checked.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+Type &Resizable_deque<Type, Mode, Growth>::operator[]( int i ) {
+	return deque_array[(deque_front + i) & (deque_capacity - 1)];
+}
+
+template <typename Type, typename Mode, typename Growth>
+Type const &Resizable_deque<Type, Mode, Growth>::operator[]( int i ) const {
+	return deque_array[(deque_front + i) & (deque_capacity - 1)];
+}
+
+/* Accessor: begin() and end()
+	These functions return random access iterators to the front element and past the back element
+*/
+
+template <typename Type, typename Mode, typename Growth>
+typename Resizable_deque<Type, Mode, Growth>::iterator Resizable_deque<Type, Mode, Growth>::begin() {
+	return iterator(this, 0);
+}
+
+template <typename Type, typename Mode, typename Growth>
+typename Resizable_deque<Type, Mode, Growth>::iterator Resizable_deque<Type, Mode, Growth>::end() {
+	return iterator(this, deque_size);
+}
+
+template <typename Type, typename Mode, typename Growth>
+typename Resizable_deque<Type, Mode, Growth>::const_iterator Resizable_deque<Type, Mode, Growth>::begin() const {
+	return const_iterator(this, 0);
+}
+
+template <typename Type, typename Mode, typename Growth>
+typename Resizable_deque<Type, Mode, Growth>::const_iterator Resizable_deque<Type, Mode, Growth>::end() const {
+	return const_iterator(this, deque_size);
+}
+
+/* Accessor: as_spans()
+	This function returns the elements, front to back, as (at most) two contiguous spans of
+	the array: from the front to the end of the array (or to the back), and from the start of
+	the array to the back. The second span is empty unless the elements wrap around.
+	The spans are valid until the next push, pop, consume() or reallocation, so they can be
+	handed to writev() and released afterwards with consume().
+*/
+
+template <typename Type, typename Mode, typename Growth>
+std::array<Deque_span<Type const>, 2> Resizable_deque<Type, Mode, Growth>::as_spans() const {
+
+	int run = std::min(deque_size, deque_capacity - deque_front);
+	return {{ Deque_span<Type const>(deque_array + deque_front, run),
+	          Deque_span<Type const>(deque_array, deque_size - run) }};
+}
+
 /* Accessor: empty()
 	This function returns true if the deque is empty or false otherwise.
 	deque_size -> member variable 
@@ -138,8 +529,8 @@ int Resizable_deque<Type>::capacity() const {
 	No errors are expected with this accessor
 */
 
-template <typename Type>
-bool Resizable_deque<Type>::empty() const {
+template <typename Type, typename Mode, typename Growth>
+bool Resizable_deque<Type, Mode, Growth>::empty() const {
 	// Condition to determine if the deque is empty or not
 	return (deque_size == 0);
 }
@@ -152,8 +543,8 @@ bool Resizable_deque<Type>::empty() const {
 	An underflow error is thrown if the deque is empty.
 */
 
-template <typename  Type>
-Type Resizable_deque<Type>::front() const {
+template <typename Type, typename Mode, typename Growth>
+Type Resizable_deque<Type, Mode, Growth>::front() const {
 	// Condition to see if the deque is empty
 	if (empty())
 		throw underflow();
@@ -165,32 +556,60 @@ Type Resizable_deque<Type>::front() const {
 	This function returns the back object of the deque.
 	deque_array -> member variable 
 	deque_back -> member variable
-	This accessor assumes deque_back >= 0.
+	The back object is in the position before deque_back.
 	An underflow error is thrown if the deque is empty.
 */
 
-template <typename  Type>
-Type Resizable_deque<Type>::back() const {
+template <typename Type, typename Mode, typename Growth>
+Type Resizable_deque<Type, Mode, Growth>::back() const {
 	// Condition to see if the deque is empty
 	if (empty())
 		throw underflow();
 	else
-		return deque_array[deque_back];
+		return deque_array[(deque_back - 1) & (deque_capacity - 1)];
 }
 
-/* Mutator: swap( Resizable_deque<Type> &deque )
+/* Mutator: swap( Resizable_deque<Type, Mode, Growth> &deque )
 	This mutator swaps all the member variables of *this deque with 
 	those of the passed argument deque.
 	deque_size
 	deque_front
 	deque_back
+	deque_reallocations
+	deque_bytes_copied
 	deque_initial_capacity
 	deque_capacity
 	deque_array 
+	Inline arrays cannot be exchanged by swapping addresses: the elements of a deque that is
+	inline are first moved to the inline array of the other deque (if that one is in the heap)
+	or to a temporary array (if both are inline), so swap() is O(N) in that case.
 */
 
-template <typename Type>
-void Resizable_deque<Type>::swap( Resizable_deque<Type> &deque ) {
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::swap( Resizable_deque<Type, Mode, Growth> &deque ) {
+
+	if (inline_capacity > 0 && (is_inline() || deque.is_inline())) {
+		if (is_inline() && deque.is_inline()) {
+			Type *temporary = std::allocator<Type>().allocate(inline_capacity);
+			try {
+				relocate_to(temporary, inline_capacity);
+			}
+			catch (...) {
+				std::allocator<Type>().deallocate(temporary, inline_capacity);
+				throw;
+			}
+			deque.swap(*this);
+			// deque now holds the temporary array: move the elements back to its inline array
+			deque.relocate_to(deque.inline_array(), inline_capacity);
+			std::allocator<Type>().deallocate(temporary, inline_capacity);
+			return;
+		}
+		// Move the inline elements to the inline array of the deque in the heap
+		if (is_inline())
+			relocate_to(deque.inline_array(), inline_capacity);
+		else
+			deque.relocate_to(this->inline_array(), inline_capacity);
+	}
 	// Swap the member variables
 	std::swap( deque_array, deque.deque_array);
 	std::swap( deque_capacity, deque.deque_capacity );
@@ -198,19 +617,21 @@ void Resizable_deque<Type>::swap( Resizable_deque<Type> &deque ) {
 	std::swap( deque_size, deque.deque_size);
 	std::swap( deque_front, deque.deque_front);
 	std::swap( deque_back, deque.deque_back);
+	std::swap( deque_reallocations, deque.deque_reallocations);
+	std::swap( deque_bytes_copied, deque.deque_bytes_copied);
 }
 
-template <typename Type>
-Resizable_deque<Type> &Resizable_deque<Type>::operator=( Resizable_deque<Type> const &rhs ) {
+template <typename Type, typename Mode, typename Growth>
+Resizable_deque<Type, Mode, Growth> &Resizable_deque<Type, Mode, Growth>::operator=( Resizable_deque<Type, Mode, Growth> const &rhs ) {
 
-	Resizable_deque<Type> copy( rhs );
+	Resizable_deque<Type, Mode, Growth> copy( rhs );
 	swap( copy );
 
 	return *this;
 }
 
-template <typename Type>
-Resizable_deque<Type> &Resizable_deque<Type>::operator=( Resizable_deque<Type> &&rhs ) {
+template <typename Type, typename Mode, typename Growth>
+Resizable_deque<Type, Mode, Growth> &Resizable_deque<Type, Mode, Growth>::operator=( Resizable_deque<Type, Mode, Growth> &&rhs ) {
 
 	swap( rhs );
 
@@ -221,25 +642,26 @@ Resizable_deque<Type> &Resizable_deque<Type>::operator=( Resizable_deque<Type> &
 	This mutator inserts an object (obj) at the front of the deque.
 	It implements member functions and member variables. 
 	It assumes a deque has been created. 
-	If the array is full, the array capacity is doubled, before the object is inserted.
+	If the array is full, the array grows (see Growth_policy), before the object is inserted.
+	obj may be an element of the deque: it is then copied from its new place after growing.
+	The front position moves back one place with a mask, so it wraps from 0 to
+	capacity - 1 without a branch.
 */
 
-template <typename Type>
-void Resizable_deque<Type>::push_front( Type const &obj ) {
-	// Check if the array is full
-	resize();
-	// Check if the array is not empty
-	if(!empty()){
-		// If the array is not empty and the front element is at place 0
-		if(deque_front == 0)
-			// The front element position is moved to the last position in the deque
-			deque_front = deque_capacity - 1;
-		else
-			// The front element position is moved to the previous position
-			deque_front--;
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::push_front( Type const &obj ) {
+	Type const *source = std::addressof(obj);
+	// Grow the array if it is full; obj may be an element (push_front( d[0] )), which grow() relocates
+	if (deque_size == deque_capacity) {
+		int index = index_of(source);
+		grow();
+		if (index >= 0) source = &(*this)[index];
 	}
-	// If the array is empty, the front element position is set to 0
-	deque_array[deque_front] = obj;
+	// The front element position is moved to the previous position
+	// The object is constructed in place before front moves, so a throwing copy leaves the deque unchanged
+	int position = (deque_front - 1) & (deque_capacity - 1);
+	new (deque_array + position) Type(*source);
+	deque_front = position;
 	// The size of the array increases by 1
 	deque_size++;
 }
@@ -248,25 +670,22 @@ void Resizable_deque<Type>::push_front( Type const &obj ) {
 	This mutator inserts an object (obj) at the back of the deque.
 	It implements member functions and member variables. 
 	It assumes a deque has been created. 
-	If the array is full, the array capacity is doubled, before the object is inserted.
+	If the array is full, the array grows (see Growth_policy), before the object is inserted.
+	obj may be an element of the deque: it is then copied from its new place after growing.
 */
 
-template <typename Type>
-void Resizable_deque<Type>::push_back( Type const &obj ) {
-	// Resize the array if it is full
-	resize();
-	// Check if the array is empty
-	if(empty()){
-		// If it is empty, the object is inserted at the position 0 
-		deque_array[deque_back] = obj;
-	}
-	else{
-		// if the array is not empty
-		// the next position is updated by 1
-		deque_back++;
-		// The objected is inserted at the new position at the back
-		deque_array[deque_back] = obj;
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::push_back( Type const &obj ) {
+	Type const *source = std::addressof(obj);
+	// Grow the array if it is full; obj may be an element (push_back( d[0] )), which grow() relocates
+	if (deque_size == deque_capacity) {
+		int index = index_of(source);
+		grow();
+		if (index >= 0) source = &(*this)[index];
 	}
+	// The object is inserted after the back element, and back moves to the next position
+	new (deque_array + deque_back) Type(*source);
+	deque_back = (deque_back + 1) & (deque_capacity - 1);
 	// The size of the array increases by 1
 	deque_size++;
 }
@@ -276,25 +695,25 @@ void Resizable_deque<Type>::push_back( Type const &obj ) {
 	It implements member functions and member variables. 
 	It assumes a deque has been created. 
 	If the array is empty, an underflow error is thrown
-	If the number of elements in the array is 1/4 or less of the array's capacity, 
-	the capacity is halved. However, it cannot be halved passed the intial capacity
+	If the number of elements in the array is 1/Shrink_divisor or less of the array's capacity,
+	the array shrinks (see Growth_policy). However, it cannot shrink passed the intial capacity
 */
 
-template <typename Type>
-void Resizable_deque<Type>::pop_front() {
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::pop_front() {
 	// Check if the array is empty 
 	if (empty()) 
 		// Exception thrown
 		throw underflow();
 	
-	// Check if the front element is different from the back element
-	if(deque_front != deque_back) 
-		// Calculates the position of the front element within the array
-		deque_front = (deque_front + 1) % deque_capacity;
+	// The front element is destroyed and its position is moved to the next position
+	deque_array[deque_front].~Type();
+	deque_front = (deque_front + 1) & (deque_capacity - 1);
 	// The size of the array decreases by 1
 	deque_size--;
-	// Resize the array if the number of elements is smaller than 1/4 of the capacity
-	resize();
+	// Shrink the array if the number of elements is 1/Shrink_divisor or less of the capacity
+	if (Growth::shrink && deque_size <= deque_capacity/Growth::shrink_divisor && deque_capacity > deque_initial_capacity)
+		shrink();
 }
 
 /* Mutator: pop_back()
@@ -302,103 +721,1258 @@ void Resizable_deque<Type>::pop_front() {
 	It implements member functions and member variables. 
 	It assumes a deque has been created. 
 	If the array is empty, an underflow error is thrown
-	If the number of elements in the array is 1/4 or less of the array's capacity, 
-	the capacity is halved. However, it cannot be halved passed the intial capacity
+	If the number of elements in the array is 1/Shrink_divisor or less of the array's capacity,
+	the array shrinks (see Growth_policy). However, it cannot shrink passed the intial capacity
 */
 
-template <typename Type>
-void Resizable_deque<Type>::pop_back() {
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::pop_back() {
 	// Check if the array is empty
 	if (empty())
 		// Exception thrown
 		throw underflow();
 	
-	// Check if the front element is different from the back element 
-	if (deque_front != deque_back)
-		// Check if the back position is 0
-		if (deque_back == 0)
-			// In this case the back position goes to the last position of the array
-			deque_back = deque_capacity - 1;
-		else 
-			// The back position is moved to the previous position
-			deque_back--;
+	// The back position is moved to the previous position and the back element is destroyed
+	deque_back = (deque_back - 1) & (deque_capacity - 1);
+	deque_array[deque_back].~Type();
 	// The size of the array decreases by 1
 	deque_size--;
-	// Resize the array if the number of elements is smaller than 1/4 of the capacity
-	resize();
+	// Shrink the array if the number of elements is 1/Shrink_divisor or less of the capacity
+	if (Growth::shrink && deque_size <= deque_capacity/Growth::shrink_divisor && deque_capacity > deque_initial_capacity)
+		shrink();
 }
 
 /* Mutator: clear()
-	This mutator empties the deque by resetting the member variables, and the array is resized
-	to the initial capacity.
+	This mutator empties the deque by destroying the elements and resetting the member variables.
+	The array keeps its capacity, so no memory is allocated or released.
 	It implements member variables
 	It assumes a deque has been created
 */
 
-template <typename Type>
-void Resizable_deque<Type>::clear() {
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::clear() {
+	// Destroy the elements
+	destroy_all();
 	// Resetting the member variables
 	deque_size = 0;
 	deque_front = 0;
 	deque_back = 0;
-	deque_capacity = deque_initial_capacity;
-	// Delete the current array
-	delete [] this->deque_array;
-	// Creates the new array with the initial capacity
-	deque_array = new Type[deque_initial_capacity];
+}
+
+/* Mutator: reserve( int n )
+	This mutator makes the capacity at least n (rounded up to a power of two) with a
+	single reallocation, so the next pushes up to n elements do not reallocate.
+	It does nothing if the capacity is already n or more.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::reserve( int n ) {
+
+	if (n > deque_capacity)
+		resize(round_capacity(n));
+}
+
+/* Mutator: shrink_to_fit()
+	This mutator reduces the capacity to the smallest power of two (at least 16) that holds
+	the elements, or to the inline array if they fit in it. It may go below the initial
+	capacity; the growth policy does not apply.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::shrink_to_fit() {
+
+	int capacity = (inline_capacity > 0 && deque_size <= inline_capacity) ? inline_capacity : round_capacity(deque_size);
+	if (capacity < deque_capacity)
+		resize(capacity);
+}
+
+/* Mutator: push_back_range( Iterator first, Iterator last )
+	This mutator inserts copies of the values in [first, last) at the back of the deque, in order.
+	The capacity is checked (and grown, with a single reallocation) once for the whole range,
+	and the values are copied into at most two contiguous runs of the array (before and after
+	the wrap point): with one memcpy per run if the range is an array of a trivially copyable type.
+	Iterator must be a forward iterator. If a copy throws, the deque is left unchanged.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+template <typename Iterator>
+void Resizable_deque<Type, Mode, Growth>::push_back_range( Iterator first, Iterator last ) {
+
+	int n = static_cast<int>(std::distance(first, last));
+	reserve_for(n);
+	construct_range(deque_back, first, n);
+
+	deque_back = (deque_back + n) & (deque_capacity - 1);
+	deque_size += n;
+}
+
+/* Mutator: push_front_range( Iterator first, Iterator last )
+	This mutator inserts copies of the values in [first, last) at the front of the deque,
+	keeping their order: *first becomes the front element (unlike repeated push_front()).
+	As with push_back_range(), there is one capacity check and at most two contiguous runs.
+	If a copy throws, the deque is left unchanged.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+template <typename Iterator>
+void Resizable_deque<Type, Mode, Growth>::push_front_range( Iterator first, Iterator last ) {
+
+	int n = static_cast<int>(std::distance(first, last));
+	reserve_for(n);
+
+	int position = (deque_front - n) & (deque_capacity - 1);
+	construct_range(position, first, n);
+
+	deque_front = position;
+	deque_size += n;
+}
+
+/* Mutator: pop_front_n( Iterator out, int n )
+	This mutator moves the first k elements, front to back, to the output iterator out and
+	removes them, where k is n or size() if smaller. It returns k (0 if the deque is empty).
+	The elements are moved from at most two contiguous runs of the array, and the capacity is
+	checked (and shrunk, with a single reallocation) once.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+template <typename Iterator>
+int Resizable_deque<Type, Mode, Growth>::pop_front_n( Iterator out, int n ) {
+
+	int count = std::max(0, std::min(n, deque_size));
+	move_out_range(deque_front, out, count);
+	destroy_range(deque_front, count);
+
+	deque_front = (deque_front + count) & (deque_capacity - 1);
+	deque_size -= count;
+	if (Growth::shrink && deque_size <= deque_capacity/Growth::shrink_divisor && deque_capacity > deque_initial_capacity)
+		shrink();
+	return count;
+}
+
+/* Mutator: pop_back_n( Iterator out, int n )
+	This mutator moves the last k elements to the output iterator out and removes them, where k
+	is n or size() if smaller, and returns k. The elements are written in the order they had in
+	the deque (not in the order of k calls to pop_back()), so pop_back_n() undoes push_back_range().
+*/
+
+template <typename Type, typename Mode, typename Growth>
+template <typename Iterator>
+int Resizable_deque<Type, Mode, Growth>::pop_back_n( Iterator out, int n ) {
+
+	int count = std::max(0, std::min(n, deque_size));
+	int position = (deque_back - count) & (deque_capacity - 1);
+	move_out_range(position, out, count);
+	destroy_range(position, count);
+
+	deque_back = position;
+	deque_size -= count;
+	if (Growth::shrink && deque_size <= deque_capacity/Growth::shrink_divisor && deque_capacity > deque_initial_capacity)
+		shrink();
+	return count;
 }
 /////////////////////////////////////////////////////////////////////////
 //                      Private member functions                       //
 /////////////////////////////////////////////////////////////////////////
 
-/* Mutator: resize()
-	This mutator resizes the array under 2 conditions:
-	- If the array is full, it doubles the capacity of the array
-	- If the number of elements is less than 1/4 of the array's capacity, it is halved,
-	but it cannot be halved passed the initial capacity.
+/* Mutator: resize( int capacity )
+	This mutator moves the elements into a new array of the given capacity (a power of two),
+	and counts the reallocation and the bytes relocated.
+	The elements are relocated to the start of the new array, so front is 0 and back is size.
+	In Inline_buffer_mode<N>, a capacity of N or less is the inline array.
+	If relocating throws, the deque keeps its old array unchanged.
 	It implements member variables
 	It assumes a deque has been created
 */
 
-template <typename Type>
-void Resizable_deque<Type>::resize() {
-	// Initialize a helper variable
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::resize( int capacity ) {
+
+	if (inline_capacity > 0 && capacity <= inline_capacity) {
+		if (is_inline()) return;
+		capacity = inline_capacity;
+	}
+	// Creates the new uninitialized array
+	Type *deque_old = deque_array;
 	int capacity_old = deque_capacity;
-	// Check if the deque is full
-	if (deque_size == deque_capacity) {
-		// Double the capacity
-		deque_capacity *= 2;
-	}
-	// Check if the number of elements is less than 1/4 of the array's capacity, then it is halved
-	// or set to the initial capacity
-	else if (deque_size <= deque_capacity/4) {
-		deque_capacity = std::max(deque_initial_capacity, deque_capacity/2);
-	}
-	// Check if the array was resized 
-	if (capacity_old != deque_capacity){
-		// Creates a new helper array
-		auto deque_old = deque_array;
-		// Resets the array
-		deque_array = new Type[deque_capacity];
-		// Copy all the elements of the old array into the new created array
-		for ( int i = 0; i < deque_size; i++ ){
-			deque_array[i] = deque_old[(i + deque_front) % capacity_old];
+	Type *deque_new = allocate(capacity);
+	try {
+		relocate_to(deque_new, capacity);
+	}
+	catch (...) {
+		deallocate(deque_new, capacity);
+		throw;
+	}
+	// Release the old array
+	deallocate(deque_old, capacity_old);
+	deque_reallocations++;
+	deque_bytes_copied += static_cast<long long>(deque_size)*sizeof(Type);
+}
+
+/* Mutator: relocate_to( Type *destination, int capacity )
+	This mutator moves the elements to the start of the uninitialized array destination of the
+	given capacity, and makes it the array of the deque: front is 0 and back is size.
+	The old array is neither released nor counted as a reallocation.
+	If relocating throws, the deque keeps its old array unchanged.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::relocate_to( Type *destination, int capacity ) {
+
+	relocate(destination);
+	// Resets the array, the front and back positions and the capacity
+	deque_array = destination;
+	deque_capacity = capacity;
+	deque_front = 0;
+	deque_back = deque_size & (capacity - 1);
+}
+
+/* Mutator: grow()
+	This mutator multiplies the capacity of a full array by the growth factor, or allocates
+	an array of the initial capacity for a moved-from deque (capacity 0).
+	An overflow error is thrown if the new capacity does not fit in an int.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::grow() {
+	// A moved-from deque has no array
+	if (deque_capacity == 0) {
+		resize(deque_initial_capacity);
+		return;
+	}
+
+	if (deque_capacity > std::numeric_limits<int>::max()/Growth::factor)
+		throw overflow();
+
+	resize(Growth::factor*deque_capacity);
+}
+
+/* Mutator: consume( int n )
+	This mutator removes the first n elements (for instance, after writev() has written them).
+	The front moves in O(1); only the destructors of the elements are called (none for
+	trivially destructible types). The capacity is not shrunk, so there is no reallocation.
+	An underflow error is thrown if the deque has fewer than n elements.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::consume( int n ) {
+
+	if (n < 0 || n > deque_size)
+		throw underflow();
+
+	destroy_range(deque_front, n);
+	deque_front = (deque_front + n) & (deque_capacity - 1);
+	deque_size -= n;
+}
+
+/* Mutator: writable_spans( int n )
+	This mutator makes room for at least n more elements (with at most one reallocation) and
+	returns the free positions after the back as (at most) two contiguous spans, for a producer
+	to fill in place (for instance, with readv()). The filled elements are added with commit().
+	The free positions hold no objects, so this is only available for trivially copyable types.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+std::array<Deque_span<Type>, 2> Resizable_deque<Type, Mode, Growth>::writable_spans( int n ) {
+
+	static_assert(std::is_trivially_copyable<Type>::value, "writable_spans() needs a trivially copyable type");
+
+	reserve_for(std::max(n, 0));
+
+	int available = deque_capacity - deque_size;
+	int run = std::min(available, deque_capacity - deque_back);
+	return {{ Deque_span<Type>(deque_array + deque_back, run),
+	          Deque_span<Type>(deque_array, available - run) }};
+}
+
+/* Mutator: commit( int n )
+	This mutator adds the first n positions of the writable spans (which the producer has
+	filled) at the back of the deque, in O(1).
+	An overflow error is thrown if there are fewer than n free positions.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::commit( int n ) {
+
+	static_assert(std::is_trivially_copyable<Type>::value, "commit() needs a trivially copyable type");
+
+	if (n < 0 || n > deque_capacity - deque_size)
+		throw overflow();
+
+	deque_back = (deque_back + n) & (deque_capacity - 1);
+	deque_size += n;
+}
+
+/* Mutator: shrink()
+	This mutator divides the capacity by the growth factor, but never below the initial capacity,
+	as many times as the shrink rule allows (more than once only after pop_front_n() or pop_back_n()),
+	with a single reallocation
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::shrink() {
+
+	int capacity = deque_capacity;
+	do {
+		capacity = std::max(deque_initial_capacity, capacity/Growth::factor);
+	} while (deque_size <= capacity/Growth::shrink_divisor && capacity > deque_initial_capacity);
+
+	resize(capacity);
+}
+
+/* Mutator: reserve_for( int n )
+	This mutator makes room for n more elements, growing the capacity by the growth factor
+	as many times as needed with a single reallocation.
+	An overflow error is thrown if the capacity does not fit in an int.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::reserve_for( int n ) {
+
+	if (n <= deque_capacity - deque_size)
+		return;
+
+	if (n > std::numeric_limits<int>::max() - deque_size)
+		throw overflow();
+
+	int capacity = (deque_capacity == 0) ? deque_initial_capacity : deque_capacity;
+	while (capacity < deque_size + n) {
+		if (capacity > std::numeric_limits<int>::max()/Growth::factor)
+			throw overflow();
+		capacity *= Growth::factor;
+	}
+
+	resize(capacity);
+}
+
+/* Helper: relocate( Type *destination )
+	This function moves the elements, front to back, to the start of the uninitialized array
+	destination and destroys them in deque_array. The elements are stored in at most two
+	contiguous segments of deque_array (before and after the wrap point):
+	- Trivially copyable elements are relocated with one memcpy per segment.
+	- Other elements are move constructed (or copied, if their move may throw) one at a time.
+	  If a copy throws, the elements already constructed in destination are destroyed
+	  and deque_array is left unchanged.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::relocate( Type *destination ) {
+
+	if (deque_size == 0) return;
+
+	// Length of the segment from front to the end of the array (or to back)
+	int first = std::min(deque_size, deque_capacity - deque_front);
+
+	if (std::is_trivially_copyable<Type>::value) {
+		std::memcpy(static_cast<void *>(destination), deque_array + deque_front, first*sizeof(Type));
+		std::memcpy(static_cast<void *>(destination + first), deque_array, (deque_size - first)*sizeof(Type));
+		return;
+	}
+
+	int i = 0;
+	try {
+		for ( ; i < deque_size; i++ ){
+			new (destination + i) Type(std::move_if_noexcept(deque_array[(deque_front + i) & (deque_capacity - 1)]));
+		}
+	}
+	catch (...) {
+		while (i > 0) destination[--i].~Type();
+		throw;
+	}
+
+	destroy_all();
+}
+
+/* Helper: construct_range( int position, Iterator first, int n )
+	This function copy constructs n values, starting at *first, in the free positions
+	position, position + 1, ... of the array (wrapping around at the end), which is at most
+	two contiguous runs. An array of a trivially copyable type is copied with one memcpy per run.
+	If a copy throws, the values already constructed are destroyed.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+template <typename Iterator>
+void Resizable_deque<Type, Mode, Growth>::construct_range( int position, Iterator first, int n ) {
+
+	if (n == 0) return;
+
+	if constexpr (std::is_trivially_copyable<Type>::value && std::is_pointer<Iterator>::value &&
+	              std::is_same<typename std::remove_cv<typename std::remove_pointer<Iterator>::type>::type, Type>::value) {
+		int run = std::min(n, deque_capacity - position);
+		std::memcpy(static_cast<void *>(deque_array + position), first, run*sizeof(Type));
+		std::memcpy(static_cast<void *>(deque_array), first + run, (n - run)*sizeof(Type));
+	}
+	else {
+		int i = 0;
+		try {
+			for ( ; i < n; i++, ++first ){
+				new (deque_array + ((position + i) & (deque_capacity - 1))) Type(*first);
+			}
+		}
+		catch (...) {
+			destroy_range(position, i);
+			throw;
 		}
-		// Resets the front and back positions
-		deque_front = 0;
-		deque_back = deque_size - 1;
-		// Delete the helper array
-		delete [] deque_old;
 	}
 }
 
-// Delete this function
-// Function used to print the deque
-// template <typename Type>
-// void Resizable_deque<Type>::print(){ // Public in order to print the array
-// 	std::cout << "F->";
-// 	for( int i = 0; i < deque_size; i++ ){
-// 		std::cout << deque_array[(i + deque_front) % deque_capacity] << "->";
-// 	}
-// 	std::cout << "B" << std::endl << std::endl;
-// }
+/* Helper: move_out_range( int position, Iterator out, int n )
+	This function moves the n elements at positions position, position + 1, ... of the array
+	(at most two contiguous runs) to the output iterator out. The moved-from elements are not
+	destroyed. An array of a trivially copyable type is written with one memcpy per run.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+template <typename Iterator>
+void Resizable_deque<Type, Mode, Growth>::move_out_range( int position, Iterator out, int n ) {
+
+	if (n == 0) return;
+
+	if constexpr (std::is_trivially_copyable<Type>::value && std::is_same<Iterator, Type *>::value) {
+		int run = std::min(n, deque_capacity - position);
+		std::memcpy(static_cast<void *>(out), deque_array + position, run*sizeof(Type));
+		std::memcpy(static_cast<void *>(out + run), deque_array, (n - run)*sizeof(Type));
+	}
+	else {
+		for ( int i = 0; i < n; i++, ++out ){
+			*out = std::move(deque_array[(position + i) & (deque_capacity - 1)]);
+		}
+	}
+}
+
+/* Helper: destroy_range( int position, int n )
+	This function destroys the n elements at positions position, position + 1, ... of the array,
+	without changing the member variables
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::destroy_range( int position, int n ) {
+
+	if (std::is_trivially_destructible<Type>::value) return;
+
+	for ( int i = 0; i < n; i++ ){
+		deque_array[(position + i) & (deque_capacity - 1)].~Type();
+	}
+}
+
+/* Helper: destroy_all()
+	This function destroys the elements in the deque, without changing the member variables
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::destroy_all() {
+
+	destroy_range(deque_front, deque_size);
+}
+
+/* Helper: index_of( Type const *address )
+	This function returns the index (counted from the front) of the element at address, or -1
+	if address is not in the array. It is only used when the array is full, so every position
+	of the array holds an element.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+int Resizable_deque<Type, Mode, Growth>::index_of( Type const *address ) const {
+
+	std::less<Type const *> before;
+	if (deque_array == nullptr || before(address, deque_array) || !before(address, deque_array + deque_capacity))
+		return -1;
+
+	return static_cast<int>((address - deque_array) - deque_front) & (deque_capacity - 1);
+}
+
+/* Helper: allocate( int n )
+	This function returns uninitialized storage for n elements; no constructor is called.
+	In Inline_buffer_mode<N>, the storage for n = N is the inline array (nothing is allocated).
+*/
+
+template <typename Type, typename Mode, typename Growth>
+Type *Resizable_deque<Type, Mode, Growth>::allocate( int n ) {
+
+	if (inline_capacity > 0 && n == inline_capacity) return this->inline_array();
+	return std::allocator<Type>().allocate(n);
+}
+
+/* Helper: deallocate( Type *array, int n )
+	This function releases storage returned by allocate( n ); the elements must have been destroyed
+*/
+
+template <typename Type, typename Mode, typename Growth>
+void Resizable_deque<Type, Mode, Growth>::deallocate( Type *array, int n ) {
+
+	if (array != nullptr && array != this->inline_array()) std::allocator<Type>().deallocate(array, n);
+}
+
+/* Helper: round_capacity( int n )
+	This function returns the smallest power of two that is greater or equal to n and to 16
+	An overflow error is thrown if that power of two does not fit in an int.
+*/
+
+template <typename Type, typename Mode, typename Growth>
+int Resizable_deque<Type, Mode, Growth>::round_capacity( int n ) {
+
+	if (n > std::numeric_limits<int>::max()/2 + 1)
+		throw overflow();
+
+	int capacity = 16;
+	while ( capacity < n ) capacity *= 2;
+	return capacity;
+}
+
+// Delete this function
+// Function used to print the deque
+// template <typename Type, typename Mode, typename Growth>
+// void Resizable_deque<Type, Mode, Growth>::print(){ // Public in order to print the array
+// 	std::cout << "F->";
+// 	for( int i = 0; i < deque_size; i++ ){
+// 		std::cout << deque_array[(i + deque_front) & (deque_capacity - 1)] << "->";
+// 	}
+// 	std::cout << "B" << std::endl << std::endl;
+// }
+
+/////////////////////////////////////////////////////////////////////////
+//                         Block map mode                              //
+/////////////////////////////////////////////////////////////////////////
+
+/* Resizable_deque<Type, Block_map_mode<N>, Growth>
+	The elements are stored in blocks of N elements. deque_map is a circular array of
+	map_capacity (a power of two) block addresses, and the blocks in use are the
+	block_count entries starting at first_block. The front element is at position
+	deque_front (0 <= deque_front < N) of the first block, so element i is at position
+	(deque_front + i) % N of block (deque_front + i) / N.
+	A block is added when a push reaches the edge of the blocks in use and removed when
+	a pop empties it. One removed block is kept as a spare, so a deque oscillating
+	around a block boundary does not allocate and release a block on every operation.
+	When the map is full it grows by the growth factor, which copies block addresses only;
+	these are the reallocations counted by reallocations() and bytes_copied().
+*/
+
+template <typename Type, int N, typename Growth>
+class Resizable_deque<Type, Block_map_mode<N>, Growth> {
+	static_assert( N > 0, "Block_map_mode<N> needs at least one element per block" );
+
+	public:
+		typedef Resizable_deque_iterator<Resizable_deque, Type> iterator;
+		typedef Resizable_deque_iterator<Resizable_deque const, Type const> const_iterator;
+
+		// Constructors
+
+		Resizable_deque( int = 0 );
+		Resizable_deque( Resizable_deque const & );
+		Resizable_deque( Resizable_deque && );
+		~Resizable_deque();
+
+		// Accessors
+
+		Type front() const;
+		Type back() const;
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+		bool is_inline() const;
+		int reallocations() const;
+		long long bytes_copied() const;
+		Type &operator[]( int );
+		Type const &operator[]( int ) const;
+		iterator begin();
+		iterator end();
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		// Mutators
+
+		void swap( Resizable_deque & );
+		Resizable_deque &operator=( Resizable_deque const& );
+		Resizable_deque &operator=( Resizable_deque && );
+		void push_front( Type const & );
+		void push_back( Type const & );
+		void pop_front();
+		void pop_back();
+		void clear();
+		void reserve( int );
+		void shrink_to_fit();
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator );
+		template <typename Iterator>
+		void push_front_range( Iterator, Iterator );
+		template <typename Iterator>
+		int pop_front_n( Iterator, int );
+		template <typename Iterator>
+		int pop_back_n( Iterator, int );
+
+	private:
+		Type **deque_map;
+		int map_capacity;
+		int first_block;
+		int block_count;
+		Type *spare_block;
+		int deque_size;
+		int deque_front;
+		int deque_reallocations;
+		long long deque_bytes_copied;
+
+		Type *element( int ) const;
+		void add_front_block();
+		void add_back_block();
+		void remove_front_block();
+		void remove_back_block();
+		Type *acquire_block();
+		void release_block( Type * );
+		void grow_map();
+		void resize_map( int );
+		void destroy_all();
+		static int round_capacity( int );
+};
+
+/* Constructor: Resizable_deque( int n )
+	This constructor creates an empty deque with a map large enough for the blocks
+	of n elements. No block is allocated until the first push.
+*/
+
+template <typename Type, int N, typename Growth>
+Resizable_deque<Type, Block_map_mode<N>, Growth>::Resizable_deque( int n )
+:deque_map(nullptr),
+map_capacity(round_capacity((n + N - 1)/N)),
+first_block(0),
+block_count(0),
+spare_block(nullptr),
+deque_size(0),
+deque_front(0),
+deque_reallocations(0),
+deque_bytes_copied(0)
+{
+	deque_map = new Type *[map_capacity]();
+}
+
+/* Copy Constructor: Resizable_deque( deque )
+	This constructor copies the elements of deque, front to back, into new blocks.
+	If a copy throws, the delegated constructor has completed, so the destructor
+	releases what was copied so far.
+*/
+
+template <typename Type, int N, typename Growth>
+Resizable_deque<Type, Block_map_mode<N>, Growth>::Resizable_deque( Resizable_deque const &deque )
+:Resizable_deque(deque.deque_size)
+{
+	for ( int i = 0; i < deque.deque_size; i++ ){
+		push_back(*deque.element(i));
+	}
+}
+
+/* Move Constructor: Resizable_deque( deque )
+	This constructor takes the map and the blocks of deque in O(1). The argument is
+	left as a valid empty deque without a map, which is allocated by its next push.
+*/
+
+template <typename Type, int N, typename Growth>
+Resizable_deque<Type, Block_map_mode<N>, Growth>::Resizable_deque( Resizable_deque &&deque )
+:deque_map(deque.deque_map),
+map_capacity(deque.map_capacity),
+first_block(deque.first_block),
+block_count(deque.block_count),
+spare_block(deque.spare_block),
+deque_size(deque.deque_size),
+deque_front(deque.deque_front),
+deque_reallocations(deque.deque_reallocations),
+deque_bytes_copied(deque.deque_bytes_copied)
+{
+	deque.deque_map = nullptr;
+	deque.map_capacity = 0;
+	deque.first_block = 0;
+	deque.block_count = 0;
+	deque.spare_block = nullptr;
+	deque.deque_size = 0;
+	deque.deque_front = 0;
+	deque.deque_reallocations = 0;
+	deque.deque_bytes_copied = 0;
+}
+
+/* Destructor: ~Resizable_deque()
+	It destroys the elements and releases the blocks, the spare block and the map
+*/
+
+template <typename Type, int N, typename Growth>
+Resizable_deque<Type, Block_map_mode<N>, Growth>::~Resizable_deque() {
+
+	destroy_all();
+	for ( int i = 0; i < block_count; i++ ){
+		std::allocator<Type>().deallocate(deque_map[(first_block + i) & (map_capacity - 1)], N);
+	}
+	if (spare_block != nullptr) std::allocator<Type>().deallocate(spare_block, N);
+	delete [] deque_map;
+}
+
+/* Accessor: size()
+	This function returns the number of elements in the deque
+*/
+
+template <typename Type, int N, typename Growth>
+int Resizable_deque<Type, Block_map_mode<N>, Growth>::size() const {
+
+	return deque_size;
+}
+
+/* Accessor: capacity()
+	This function returns the number of elements that fit in the allocated blocks
+	(the blocks in use and the spare block)
+*/
+
+template <typename Type, int N, typename Growth>
+int Resizable_deque<Type, Block_map_mode<N>, Growth>::capacity() const {
+
+	return (block_count + (spare_block != nullptr))*N;
+}
+
+/* Accessor: is_inline()
+	This function returns false: the blocks are always on the heap
+*/
+
+template <typename Type, int N, typename Growth>
+bool Resizable_deque<Type, Block_map_mode<N>, Growth>::is_inline() const {
+
+	return false;
+}
+
+/* Accessor: reallocations()
+	This function returns the number of times the map of block addresses has been reallocated
+*/
+
+template <typename Type, int N, typename Growth>
+int Resizable_deque<Type, Block_map_mode<N>, Growth>::reallocations() const {
+
+	return deque_reallocations;
+}
+
+/* Accessor: bytes_copied()
+	This function returns the number of bytes of block addresses copied by those reallocations
+	(elements are never copied in this mode)
+*/
+
+template <typename Type, int N, typename Growth>
+long long Resizable_deque<Type, Block_map_mode<N>, Growth>::bytes_copied() const {
+
+	return deque_bytes_copied;
+}
+
+/* Accessor: operator[]( int i )
+	This function returns a reference to element i, counted from the front (0 <= i < size()).
+	The index is not checked.
+*/
+
+template <typename Type, int N, typename Growth>
+Type &Resizable_deque<Type, Block_map_mode<N>, Growth>::operator[]( int i ) {
+
+	return *element(i);
+}
+
+template <typename Type, int N, typename Growth>
+Type const &Resizable_deque<Type, Block_map_mode<N>, Growth>::operator[]( int i ) const {
+
+	return *element(i);
+}
+
+/* Accessor: begin() and end()
+	These functions return random access iterators to the front element and past the back element
+*/
+
+template <typename Type, int N, typename Growth>
+typename Resizable_deque<Type, Block_map_mode<N>, Growth>::iterator Resizable_deque<Type, Block_map_mode<N>, Growth>::begin() {
+
+	return iterator(this, 0);
+}
+
+template <typename Type, int N, typename Growth>
+typename Resizable_deque<Type, Block_map_mode<N>, Growth>::iterator Resizable_deque<Type, Block_map_mode<N>, Growth>::end() {
+
+	return iterator(this, deque_size);
+}
+
+template <typename Type, int N, typename Growth>
+typename Resizable_deque<Type, Block_map_mode<N>, Growth>::const_iterator Resizable_deque<Type, Block_map_mode<N>, Growth>::begin() const {
+
+	return const_iterator(this, 0);
+}
+
+template <typename Type, int N, typename Growth>
+typename Resizable_deque<Type, Block_map_mode<N>, Growth>::const_iterator Resizable_deque<Type, Block_map_mode<N>, Growth>::end() const {
+
+	return const_iterator(this, deque_size);
+}
+
+/* Accessor: empty()
+	This function returns true if the deque is empty or false otherwise
+*/
+
+template <typename Type, int N, typename Growth>
+bool Resizable_deque<Type, Block_map_mode<N>, Growth>::empty() const {
+
+	return (deque_size == 0);
+}
+
+/* Accessor: front()
+	This function returns the front object of the deque.
+	An underflow error is thrown if the deque is empty.
+*/
+
+template <typename Type, int N, typename Growth>
+Type Resizable_deque<Type, Block_map_mode<N>, Growth>::front() const {
+
+	if (empty())
+		throw underflow();
+
+	return *element(0);
+}
+
+/* Accessor: back()
+	This function returns the back object of the deque.
+	An underflow error is thrown if the deque is empty.
+*/
+
+template <typename Type, int N, typename Growth>
+Type Resizable_deque<Type, Block_map_mode<N>, Growth>::back() const {
+
+	if (empty())
+		throw underflow();
+
+	return *element(deque_size - 1);
+}
+
+/* Mutator: swap( Resizable_deque &deque )
+	This mutator swaps all the member variables of *this deque with those of deque
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::swap( Resizable_deque &deque ) {
+
+	std::swap( deque_map, deque.deque_map );
+	std::swap( map_capacity, deque.map_capacity );
+	std::swap( first_block, deque.first_block );
+	std::swap( block_count, deque.block_count );
+	std::swap( spare_block, deque.spare_block );
+	std::swap( deque_size, deque.deque_size );
+	std::swap( deque_front, deque.deque_front );
+	std::swap( deque_reallocations, deque.deque_reallocations );
+	std::swap( deque_bytes_copied, deque.deque_bytes_copied );
+}
+
+template <typename Type, int N, typename Growth>
+Resizable_deque<Type, Block_map_mode<N>, Growth> &Resizable_deque<Type, Block_map_mode<N>, Growth>::operator=( Resizable_deque const &rhs ) {
+
+	Resizable_deque copy( rhs );
+	swap( copy );
+
+	return *this;
+}
+
+template <typename Type, int N, typename Growth>
+Resizable_deque<Type, Block_map_mode<N>, Growth> &Resizable_deque<Type, Block_map_mode<N>, Growth>::operator=( Resizable_deque &&rhs ) {
+
+	swap( rhs );
+
+	return *this;
+}
+
+/* Mutator: push_front( Type const &obj )
+	This mutator inserts obj at the front of the deque. If the first block is full a
+	block is added in front of it. No element is moved.
+	If the copy of obj throws, the added block is removed and the deque is unchanged.
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::push_front( Type const &obj ) {
+
+	bool new_block = (deque_front == 0);
+	if (new_block)
+		add_front_block();
+
+	try {
+		new (element(-1)) Type(obj);
+	}
+	catch (...) {
+		if (new_block) remove_front_block();
+		throw;
+	}
+
+	deque_front--;
+	deque_size++;
+}
+
+/* Mutator: push_back( Type const &obj )
+	This mutator inserts obj at the back of the deque. If the last block is full (or
+	there is no block) a block is added after it. No element is moved.
+	If the copy of obj throws, the added block is removed and the deque is unchanged.
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::push_back( Type const &obj ) {
+
+	bool new_block = (deque_front + deque_size == block_count*N);
+	if (new_block)
+		add_back_block();
+
+	try {
+		new (element(deque_size)) Type(obj);
+	}
+	catch (...) {
+		if (new_block) remove_back_block();
+		throw;
+	}
+
+	deque_size++;
+}
+
+/* Mutator: pop_front()
+	This mutator removes the front object of the deque, and removes the first block if it is left empty.
+	If the deque is empty, an underflow error is thrown
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::pop_front() {
+
+	if (empty())
+		throw underflow();
+
+	element(0)->~Type();
+	deque_front++;
+	deque_size--;
+
+	if (deque_front == N)
+		remove_front_block();
+}
+
+/* Mutator: pop_back()
+	This mutator removes the back object of the deque, and removes the last block if it is left empty.
+	If the deque is empty, an underflow error is thrown
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::pop_back() {
+
+	if (empty())
+		throw underflow();
+
+	element(deque_size - 1)->~Type();
+	deque_size--;
+
+	if (deque_front + deque_size == (block_count - 1)*N)
+		remove_back_block();
+}
+
+/* Mutator: clear()
+	This mutator destroys the elements and removes the blocks (keeping one as the spare block).
+	The map keeps its capacity.
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::clear() {
+
+	destroy_all();
+	while (block_count > 0)
+		remove_back_block();
+	deque_size = 0;
+	deque_front = 0;
+}
+
+/* Mutator: reserve( int n )
+	This mutator makes the map large enough for the blocks of n elements, so the next
+	pushes up to n elements do not reallocate the map. Blocks are still allocated one at a time.
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::reserve( int n ) {
+
+	// The first block may be partly unused, so one more block is needed
+	int blocks = (n + N - 1)/N + 1;
+	if (blocks > map_capacity)
+		resize_map(round_capacity(blocks));
+}
+
+/* Mutator: shrink_to_fit()
+	This mutator releases the spare block and shrinks the map to the blocks in use
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::shrink_to_fit() {
+
+	if (spare_block != nullptr) {
+		std::allocator<Type>().deallocate(spare_block, N);
+		spare_block = nullptr;
+	}
+
+	int capacity = round_capacity(block_count);
+	if (capacity < map_capacity)
+		resize_map(capacity);
+}
+
+/* Mutator: push_back_range( Iterator first, Iterator last )
+	This mutator inserts copies of the values in [first, last) at the back of the deque, in order.
+	The map is reserved once for the whole range; the values are then copied one at a time,
+	adding blocks as they fill. Iterator must be a forward iterator.
+	If a copy throws, the deque is left unchanged.
+*/
+
+template <typename Type, int N, typename Growth>
+template <typename Iterator>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::push_back_range( Iterator first, Iterator last ) {
+
+	int n = static_cast<int>(std::distance(first, last));
+	reserve(deque_size + n);
+
+	int i = 0;
+	try {
+		for ( ; i < n; i++, ++first ){
+			push_back(*first);
+		}
+	}
+	catch (...) {
+		while (i-- > 0) pop_back();
+		throw;
+	}
+}
+
+/* Mutator: push_front_range( Iterator first, Iterator last )
+	This mutator inserts copies of the values in [first, last) at the front of the deque,
+	keeping their order: *first becomes the front element (unlike repeated push_front()).
+	The values are pushed from last to first, so a forward (not bidirectional) iterator
+	is first stepped through the range once to record its positions.
+	If a copy throws, the deque is left unchanged.
+*/
+
+template <typename Type, int N, typename Growth>
+template <typename Iterator>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::push_front_range( Iterator first, Iterator last ) {
+
+	int n = static_cast<int>(std::distance(first, last));
+	reserve(deque_size + n);
+
+	int i = 0;
+	try {
+		if constexpr (std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>::value) {
+			for ( ; i < n; i++ ){
+				push_front(*--last);
+			}
+		}
+		else {
+			std::vector<Iterator> positions;
+			positions.reserve(n);
+			for ( ; first != last; ++first ){
+				positions.push_back(first);
+			}
+			for ( ; i < n; i++ ){
+				push_front(*positions[n - 1 - i]);
+			}
+		}
+	}
+	catch (...) {
+		while (i-- > 0) pop_front();
+		throw;
+	}
+}
+
+/* Mutator: pop_front_n( Iterator out, int n )
+	This mutator moves the first k elements, front to back, to the output iterator out and
+	removes them, where k is n or size() if smaller. It returns k (0 if the deque is empty).
+*/
+
+template <typename Type, int N, typename Growth>
+template <typename Iterator>
+int Resizable_deque<Type, Block_map_mode<N>, Growth>::pop_front_n( Iterator out, int n ) {
+
+	int count = std::max(0, std::min(n, deque_size));
+	for ( int i = 0; i < count; i++, ++out ){
+		*out = std::move(*element(0));
+		pop_front();
+	}
+	return count;
+}
+
+/* Mutator: pop_back_n( Iterator out, int n )
+	This mutator moves the last k elements to the output iterator out and removes them, where k
+	is n or size() if smaller, and returns k. The elements are written in the order they had in
+	the deque (not in the order of k calls to pop_back()), so pop_back_n() undoes push_back_range().
+*/
+
+template <typename Type, int N, typename Growth>
+template <typename Iterator>
+int Resizable_deque<Type, Block_map_mode<N>, Growth>::pop_back_n( Iterator out, int n ) {
+
+	int count = std::max(0, std::min(n, deque_size));
+	for ( int i = deque_size - count; i < deque_size; i++, ++out ){
+		*out = std::move(*element(i));
+	}
+	for ( int i = 0; i < count; i++ ){
+		pop_back();
+	}
+	return count;
+}
+
+/* Helper: element( int i )
+	This function returns the address of element i (counted from the front). It is also
+	used for the slot just before the front (i = -1) while the front block has room.
+*/
+
+template <typename Type, int N, typename Growth>
+Type *Resizable_deque<Type, Block_map_mode<N>, Growth>::element( int i ) const {
+
+	int position = deque_front + i;
+	return deque_map[(first_block + position/N) & (map_capacity - 1)] + position%N;
+}
+
+/* Helper: add_front_block()
+	This function inserts a block before the first block; the front is moved to the end of the new block
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::add_front_block() {
+
+	if (block_count == map_capacity)
+		grow_map();
+
+	Type *block = acquire_block();
+	first_block = (first_block - 1) & (map_capacity - 1);
+	deque_map[first_block] = block;
+	block_count++;
+	deque_front = N;
+}
+
+/* Helper: add_back_block()
+	This function appends a block after the last block
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::add_back_block() {
+
+	if (block_count == map_capacity)
+		grow_map();
+
+	deque_map[(first_block + block_count) & (map_capacity - 1)] = acquire_block();
+	block_count++;
+}
+
+/* Helper: remove_front_block()
+	This function removes the (empty) first block; the front moves to the start of the next block
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::remove_front_block() {
+
+	release_block(deque_map[first_block]);
+	deque_map[first_block] = nullptr;
+	first_block = (first_block + 1) & (map_capacity - 1);
+	block_count--;
+	deque_front = 0;
+}
+
+/* Helper: remove_back_block()
+	This function removes the (empty) last block
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::remove_back_block() {
+
+	int last = (first_block + block_count - 1) & (map_capacity - 1);
+	release_block(deque_map[last]);
+	deque_map[last] = nullptr;
+	block_count--;
+}
+
+/* Helper: acquire_block()
+	This function returns the spare block if there is one, or allocates a new block
+*/
+
+template <typename Type, int N, typename Growth>
+Type *Resizable_deque<Type, Block_map_mode<N>, Growth>::acquire_block() {
+
+	if (spare_block == nullptr)
+		return std::allocator<Type>().allocate(N);
+
+	Type *block = spare_block;
+	spare_block = nullptr;
+	return block;
+}
+
+/* Helper: release_block( Type *block )
+	This function keeps block as the spare block, or releases it if there is a spare block already
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::release_block( Type *block ) {
+
+	if (spare_block == nullptr)
+		spare_block = block;
+	else
+		std::allocator<Type>().deallocate(block, N);
+}
+
+/* Helper: grow_map()
+	This function multiplies the capacity of a full map by the growth factor (or creates
+	the map, after a move)
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::grow_map() {
+
+	if (map_capacity == 0)
+		resize_map(round_capacity(0));
+	else if (map_capacity > std::numeric_limits<int>::max()/Growth::factor)
+		throw overflow();
+	else
+		resize_map(Growth::factor*map_capacity);
+}
+
+/* Helper: resize_map( int capacity )
+	This function moves the block addresses, in order, to the start of a new map of the
+	given capacity (a power of two). The elements themselves are not touched.
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::resize_map( int capacity ) {
+
+	Type **map_new = new Type *[capacity]();
+
+	for ( int i = 0; i < block_count; i++ ){
+		map_new[i] = deque_map[(first_block + i) & (map_capacity - 1)];
+	}
+
+	// Creating the map of a moved-from deque is not a reallocation
+	if (deque_map != nullptr) {
+		deque_reallocations++;
+		deque_bytes_copied += static_cast<long long>(block_count)*sizeof(Type *);
+	}
+
+	delete [] deque_map;
+	deque_map = map_new;
+	map_capacity = capacity;
+	first_block = 0;
+}
+
+/* Helper: destroy_all()
+	This function destroys the elements in the deque, without changing the member variables
+*/
+
+template <typename Type, int N, typename Growth>
+void Resizable_deque<Type, Block_map_mode<N>, Growth>::destroy_all() {
+
+	if (std::is_trivially_destructible<Type>::value) return;
+
+	for ( int i = 0; i < deque_size; i++ ){
+		element(i)->~Type();
+	}
+}
+
+/* Helper: round_capacity( int n )
+	This function returns the smallest power of two that is greater or equal to n and to 8
+	An overflow error is thrown if that power of two does not fit in an int.
+*/
+
+template <typename Type, int N, typename Growth>
+int Resizable_deque<Type, Block_map_mode<N>, Growth>::round_capacity( int n ) {
+
+	if (n > std::numeric_limits<int>::max()/2 + 1)
+		throw overflow();
+
+	int capacity = 8;
+	while ( capacity < n ) capacity *= 2;
+	return capacity;
+}
+
+#endif
@@ -0,0 +1,292 @@
+// Microbenchmark of Resizable_deque: nanoseconds per operation of push and pop at both ends,
+// compared with the index arithmetic the deque used before its capacity was made a power of
+// two (Modulo_deque below) and with std::deque; and the cost of creating and destroying
+// small deques with Inline_deque, Resizable_deque and std::deque.
+//
+// Build:	g++ -std=c++17 -O2 2_Resizable_deque_benchmark.cpp -o deque_benchmark
+// Run:		./deque_benchmark [operations per test (default 20000000)] [small deques (default 1000000)]
+//
+// Every test is run three times and the fastest run is printed.
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+// The exceptions thrown by the deque
+class underflow {};
+class overflow {};
+class illegal_argument {};
+
+#include "2_Resizable_deque.h"
+
+/*
+	Modulo_deque is the baseline: the circular array of Resizable_deque before the change,
+	with a capacity that is any number from 16 up, an integer division to advance the front
+	(front + 1) % capacity, and branches to step the front and back around the end of the
+	array. It doubles when full and halves when a quarter full, as Resizable_deque does.
+*/
+template <typename Type>
+class Modulo_deque {
+	public:
+		Modulo_deque( int n = 16 ):
+		deque_capacity( std::max( n, 16 ) ),
+		deque_initial_capacity( deque_capacity ),
+		deque_size( 0 ),
+		deque_front( 0 ),
+		deque_back( deque_capacity - 1 ),
+		deque_array( new Type[deque_capacity] ) {}
+
+		~Modulo_deque() { delete [] deque_array; }
+
+		Type front() const { return deque_array[deque_front]; }
+		Type back() const { return deque_array[deque_back]; }
+		bool empty() const { return deque_size == 0; }
+
+		void push_front( Type const &obj ) {
+			if ( deque_size == deque_capacity ) resize( 2*deque_capacity );
+			deque_front = ( deque_front == 0 ) ? deque_capacity - 1 : deque_front - 1;
+			deque_array[deque_front] = obj;
+			++deque_size;
+		}
+
+		void push_back( Type const &obj ) {
+			if ( deque_size == deque_capacity ) resize( 2*deque_capacity );
+			deque_back = ( deque_back + 1 ) % deque_capacity;
+			deque_array[deque_back] = obj;
+			++deque_size;
+		}
+
+		void pop_front() {
+			deque_front = ( deque_front + 1 ) % deque_capacity;
+			--deque_size;
+			shrink();
+		}
+
+		void pop_back() {
+			deque_back = ( deque_back == 0 ) ? deque_capacity - 1 : deque_back - 1;
+			--deque_size;
+			shrink();
+		}
+
+	private:
+		int deque_capacity;
+		int deque_initial_capacity;
+		int deque_size;
+		int deque_front;
+		int deque_back;
+		Type *deque_array;
+
+		void shrink() {
+			if ( deque_size <= deque_capacity/4 and deque_capacity/2 >= deque_initial_capacity ) {
+				resize( deque_capacity/2 );
+			}
+		}
+
+		void resize( int capacity ) {
+			Type *array = new Type[capacity];
+			for ( int i = 0; i < deque_size; ++i ) {
+				array[i] = deque_array[( deque_front + i ) % deque_capacity];
+			}
+			delete [] deque_array;
+			deque_array = array;
+			deque_capacity = capacity;
+			deque_front = 0;
+			deque_back = ( deque_size == 0 ) ? capacity - 1 : deque_size - 1;
+		}
+};
+
+static double elapsed( std::chrono::steady_clock::time_point start ) {
+	return std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Keeps the compiler from dropping the values read by the tests
+static volatile std::int64_t sink;
+
+/*
+	The tests. Each one performs about count operations on a deque that holds around
+	size values and returns the number of nanoseconds per operation.
+	queue:	push_back and pop_front (a FIFO of size values)
+	stack:	push_front and pop_front at the same end
+	mixed:	a push or a pop at a random end, so the end taken is unpredictable
+	grow:	count push_back into an empty deque, then count pop_back (every resize)
+*/
+template <typename Deque>
+double queue_test( long count, int size ) {
+	Deque deque;
+	for ( int i = 0; i < size; ++i ) deque.push_back( i );
+
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( long i = 0; i < count; ++i ) {
+		deque.push_back( static_cast<int>( i ) );
+		sum += deque.front();
+		deque.pop_front();
+	}
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/( 2.0*count );
+}
+
+template <typename Deque>
+double stack_test( long count, int size ) {
+	Deque deque;
+	for ( int i = 0; i < size; ++i ) deque.push_back( i );
+
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( long i = 0; i < count; ++i ) {
+		deque.push_front( static_cast<int>( i ) );
+		sum += deque.front();
+		deque.pop_front();
+	}
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/( 2.0*count );
+}
+
+template <typename Deque>
+double mixed_test( long count, int size, std::vector<std::uint8_t> const &choices ) {
+	Deque deque;
+	for ( int i = 0; i < size; ++i ) deque.push_back( i );
+
+	std::int64_t sum = 0;
+	int held = size;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( long i = 0; i < count; ++i ) {
+		std::uint8_t choice = choices[i & ( choices.size() - 1 )];
+
+		// Push if below the target size and pop if above it, at a random end
+		if ( held <= size/2 or ( held < 2*size and ( choice & 2 ) ) ) {
+			if ( choice & 1 ) deque.push_back( static_cast<int>( i ) );
+			else deque.push_front( static_cast<int>( i ) );
+			++held;
+		}
+		else {
+			if ( choice & 1 ) {
+				sum += deque.back();
+				deque.pop_back();
+			}
+			else {
+				sum += deque.front();
+				deque.pop_front();
+			}
+			--held;
+		}
+	}
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/count;
+}
+
+template <typename Deque>
+double grow_test( long count ) {
+	Deque deque;
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( long i = 0; i < count; ++i ) deque.push_back( static_cast<int>( i ) );
+	while ( !deque.empty() ) {
+		sum += deque.back();
+		deque.pop_back();
+	}
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/( 2.0*count );
+}
+
+/*
+	small_test creates count deques one after the other, pushes held values into each,
+	pops them and destroys the deque, and returns the nanoseconds per deque
+*/
+template <typename Deque>
+double small_test( long count, int held ) {
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( long i = 0; i < count; ++i ) {
+		Deque deque;
+		for ( int j = 0; j < held; ++j ) deque.push_back( j );
+		while ( !deque.empty() ) {
+			sum += deque.front();
+			deque.pop_front();
+		}
+	}
+
+	double ns = elapsed( start );
+	sink = sum;
+	return ns/count;
+}
+
+template <typename Test>
+double best_of_three( Test test ) {
+	double best = test();
+	for ( int i = 0; i < 2; ++i ) best = std::min( best, test() );
+	return best;
+}
+
+template <typename Deque>
+void run( std::string const &name, long count, std::vector<std::uint8_t> const &choices ) {
+	std::cout << std::left << std::setw( 18 ) << name << std::right << std::fixed << std::setprecision( 2 );
+
+	for ( int size: { 64, 100000 } ) {
+		std::cout << std::setw( 12 ) << best_of_three( [&]{ return queue_test<Deque>( count, size ); } )
+		          << std::setw( 12 ) << best_of_three( [&]{ return stack_test<Deque>( count, size ); } )
+		          << std::setw( 12 ) << best_of_three( [&]{ return mixed_test<Deque>( count, size, choices ); } );
+	}
+
+	std::cout << std::setw( 12 ) << best_of_three( [&]{ return grow_test<Deque>( count/4 ); } ) << std::endl;
+}
+
+template <typename Deque>
+void run_small( std::string const &name, long count ) {
+	std::cout << std::left << std::setw( 18 ) << name << std::right << std::fixed << std::setprecision( 2 );
+
+	for ( int held: { 0, 4, 8, 12 } ) {
+		std::cout << std::setw( 12 ) << best_of_three( [&]{ return small_test<Deque>( count, held ); } );
+	}
+
+	std::cout << std::endl;
+}
+
+int main( int argc, char **argv ) {
+	long count = ( argc > 1 ) ? std::atol( argv[1] ) : 20000000;
+	long small_count = ( argc > 2 ) ? std::atol( argv[2] ) : 1000000;
+
+	std::vector<std::uint8_t> choices( 1 << 16 );
+	std::mt19937 random( 42 );
+	for ( auto &choice: choices ) choice = static_cast<std::uint8_t>( random() );
+
+	std::cout << "ns per operation (int values)" << std::endl
+	          << std::left << std::setw( 18 ) << "deque" << std::right
+	          << std::setw( 12 ) << "queue 64" << std::setw( 12 ) << "stack 64" << std::setw( 12 ) << "mixed 64"
+	          << std::setw( 12 ) << "queue 100k" << std::setw( 12 ) << "stack 100k" << std::setw( 12 ) << "mixed 100k"
+	          << std::setw( 12 ) << "grow" << std::endl;
+
+	run<Modulo_deque<int>>( "before (modulo)", count, choices );
+	run<Resizable_deque<int>>( "Resizable_deque", count, choices );
+	run<std::deque<int>>( "std::deque", count, choices );
+
+	// Inline_deque<int, 8> holds up to 8 values without allocating; 12 values spill to the heap
+	std::cout << std::endl << "ns per small deque (create, push, pop and destroy), by values held" << std::endl
+	          << std::left << std::setw( 18 ) << "deque" << std::right
+	          << std::setw( 12 ) << "0" << std::setw( 12 ) << "4" << std::setw( 12 ) << "8" << std::setw( 12 ) << "12" << std::endl;
+
+	run_small<Inline_deque<int, 8>>( "Inline_deque<8>", small_count );
+	run_small<Resizable_deque<int>>( "Resizable_deque", small_count );
+	run_small<std::deque<int>>( "std::deque", small_count );
+
+	return 0;
+}
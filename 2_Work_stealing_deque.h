@@ -0,0 +1,656 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "2_Resizable_deque.h"
+
+/* Work_stealing_deque<Type>
+	The deque of a work-stealing scheduler (D. Chase and Y. Lev, SPAA 2005, with the C11
+	memory orderings of N. M. Le et al., PPoPP 2013). It has the two-ended circular array
+	shape of Resizable_deque: a power-of-two array indexed by masking, with deque_top (the
+	front) and deque_bottom (one past the back) as counters that only grow.
+	- The owner thread pushes and pops at the back (push_back, pop_back), like a stack,
+	  so it works on the most recent (cache-warm) task.
+	- Any other thread steals from the front (steal) with a compare-and-swap on deque_top.
+	  The owner only races with thieves for the last value.
+	When the array is full the owner copies the values into an array of twice the capacity
+	and publishes it with a release store. Thieves may still be reading the old array, so
+	it is not released at once: it is retired to a list that the destructor releases.
+	The retired arrays add up to less than the capacity of the current array.
+	Values are copied while another thread may be reading them, so Type must be trivially
+	copyable (a task pointer, an index, ...).
+	pop_back() and steal() return false when there is nothing to take; steal() also returns
+	false when it loses a race with another thread, and the caller may try another deque.
+*/
+
+template <typename Type>
+class Work_stealing_deque {
+	static_assert( std::is_trivially_copyable<Type>::value, "Work_stealing_deque needs a trivially copyable type" );
+
+	public:
+
+		// Constructors
+
+		Work_stealing_deque( int = 64 );
+		Work_stealing_deque( Work_stealing_deque const & ) = delete;
+		Work_stealing_deque &operator=( Work_stealing_deque const & ) = delete;
+		~Work_stealing_deque();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		// Mutators (owner)
+
+		void push_back( Type );
+		bool pop_back( Type & );
+
+		// Mutators (any thread)
+
+		bool steal( Type & );
+
+	private:
+		class Ring_array {
+			public:
+				Ring_array( std::int64_t, Ring_array * );
+				~Ring_array();
+
+				Type get( std::int64_t ) const;
+				void put( std::int64_t, Type );
+
+				std::int64_t array_capacity;
+				std::atomic<Type> *array_values;
+				Ring_array *retired_array;
+		};
+
+		alignas( 64 ) std::atomic<std::int64_t> deque_top;
+		alignas( 64 ) std::atomic<std::int64_t> deque_bottom;
+		std::atomic<Ring_array *> deque_array;
+
+		Ring_array *grow( Ring_array *, std::int64_t, std::int64_t );
+};
+
+class Task_group;
+
+/* Work_stealing_pool
+	A fixed set of worker threads, each owning a Work_stealing_deque of tasks.
+	Tasks are created through a Task_group (fork/join):
+		Work_stealing_pool pool( 4 );
+		Task_group group( pool );
+		group.run( [&]{ ... } );    // fork
+		group.wait();               // join
+	A task run by a worker thread goes on the back of that worker's deque; a task run by
+	any other thread goes on a shared queue (pool_injected, behind a mutex).
+	A worker looks for work in its own deque (newest task first), then in the shared queue,
+	then steals the oldest task of another worker chosen at random. After a run of failed
+	attempts it sleeps on a condition variable until new work is announced (or for at most
+	a millisecond, so a lost notification only costs a short delay).
+	Task_group::wait() does not block the thread: it runs tasks (its own or stolen) until
+	the group is done, so nested fork/join (parallel fib) does not deadlock the workers.
+	All task groups must have been waited for before the pool is destroyed.
+*/
+
+class Work_stealing_pool {
+	public:
+
+		// Constructors
+
+		Work_stealing_pool( int = 0 );
+		Work_stealing_pool( Work_stealing_pool const & ) = delete;
+		Work_stealing_pool &operator=( Work_stealing_pool const & ) = delete;
+		~Work_stealing_pool();
+
+		// Accessors
+
+		int size() const;
+
+	private:
+		class Task {
+			public:
+				Task( std::function<void()> &&, Task_group * );
+
+				std::function<void()> task_function;
+				Task_group *task_group;
+		};
+
+		class Worker_context {
+			public:
+				Work_stealing_pool *pool;
+				int index;
+				std::uint32_t random_state;
+		};
+
+		std::vector<Work_stealing_deque<Task *> *> pool_deques;
+		std::vector<std::thread> pool_threads;
+		Resizable_deque<Task *> pool_injected;
+		std::mutex pool_mutex;
+		std::condition_variable pool_idle;
+		std::atomic<int> pool_sleeping;
+		std::atomic<bool> pool_stop;
+
+		static int const SPIN_ROUNDS = 64;
+
+		void spawn( Task * );
+		bool run_one();
+		Task *find_task();
+		void execute( Task * );
+		void notify();
+		void worker_loop( int );
+
+		static Worker_context &context();
+
+		friend class Task_group;
+};
+
+/* Task_group
+	A set of tasks forked on a Work_stealing_pool. wait() returns when all of them (and the
+	tasks they ran on the same group) have finished. If a task throws, the first exception
+	is stored and rethrown by wait(), after all the tasks have finished.
+*/
+
+class Task_group {
+	public:
+
+		// Constructors
+
+		Task_group( Work_stealing_pool & );
+		Task_group( Task_group const & ) = delete;
+		Task_group &operator=( Task_group const & ) = delete;
+		~Task_group();
+
+		// Mutators
+
+		template <typename Function>
+		void run( Function && );
+		void wait();
+
+	private:
+		Work_stealing_pool &group_pool;
+		std::atomic<int> group_pending;
+		std::mutex group_mutex;
+		std::exception_ptr group_exception;
+
+		void finish( std::exception_ptr );
+
+		friend class Work_stealing_pool;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                        Work_stealing_deque                          //
+/////////////////////////////////////////////////////////////////////////
+
+/* Constructor: Work_stealing_deque( int n )
+	This constructor creates an empty deque with an array of n values (rounded up to a power of two)
+*/
+
+template <typename Type>
+Work_stealing_deque<Type>::Work_stealing_deque( int n ):
+deque_top( 0 ),
+deque_bottom( 0 ),
+deque_array( nullptr )
+{
+	std::int64_t capacity = 16;
+	while ( capacity < n ) capacity *= 2;
+
+	deque_array.store( new Ring_array( capacity, nullptr ) );
+}
+
+/* Destructor: ~Work_stealing_deque()
+	It releases the current array and every retired array.
+	No other thread may be using the deque.
+*/
+
+template <typename Type>
+Work_stealing_deque<Type>::~Work_stealing_deque() {
+
+	Ring_array *array = deque_array.load();
+	while ( array != nullptr ) {
+		Ring_array *retired = array->retired_array;
+		delete array;
+		array = retired;
+	}
+}
+
+/* Accessor: size()
+	This function returns the number of values in the deque. It is exact only when no
+	other thread is using the deque.
+*/
+
+template <typename Type>
+int Work_stealing_deque<Type>::size() const {
+
+	std::int64_t bottom = deque_bottom.load( std::memory_order_relaxed );
+	std::int64_t top = deque_top.load( std::memory_order_relaxed );
+	return ( bottom > top ) ? static_cast<int>( bottom - top ) : 0;
+}
+
+template <typename Type>
+bool Work_stealing_deque<Type>::empty() const {
+
+	return ( size() == 0 );
+}
+
+template <typename Type>
+int Work_stealing_deque<Type>::capacity() const {
+
+	return static_cast<int>( deque_array.load( std::memory_order_relaxed )->array_capacity );
+}
+
+/* Mutator: push_back( obj )
+	This mutator (owner only) inserts obj at the back of the deque, growing the array if it is full.
+	The release fence makes the value visible before the new bottom.
+*/
+
+template <typename Type>
+void Work_stealing_deque<Type>::push_back( Type obj ) {
+
+	std::int64_t bottom = deque_bottom.load( std::memory_order_relaxed );
+	std::int64_t top = deque_top.load( std::memory_order_acquire );
+	Ring_array *array = deque_array.load( std::memory_order_relaxed );
+
+	if ( bottom - top > array->array_capacity - 1 ) {
+		array = grow( array, bottom, top );
+	}
+
+	array->put( bottom, obj );
+	std::atomic_thread_fence( std::memory_order_release );
+	deque_bottom.store( bottom + 1, std::memory_order_relaxed );
+}
+
+/* Mutator: pop_back( obj )
+	This mutator (owner only) removes the back value of the deque and stores it in obj.
+	The bottom is lowered first, and the sequentially consistent fence orders it with the
+	read of the top, so a thief and the owner can not both take the last value: for the
+	last value they race with a compare-and-swap on the top.
+	It returns false if the deque is empty (or a thief took the last value).
+*/
+
+template <typename Type>
+bool Work_stealing_deque<Type>::pop_back( Type &obj ) {
+
+	std::int64_t bottom = deque_bottom.load( std::memory_order_relaxed ) - 1;
+	Ring_array *array = deque_array.load( std::memory_order_relaxed );
+	deque_bottom.store( bottom, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	std::int64_t top = deque_top.load( std::memory_order_relaxed );
+
+	if ( top > bottom ) {
+		// Empty: restore the bottom
+		deque_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return false;
+	}
+
+	obj = array->get( bottom );
+	if ( top < bottom ) return true;
+
+	// Last value: race with the thieves for it
+	bool won = deque_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+	deque_bottom.store( bottom + 1, std::memory_order_relaxed );
+	return won;
+}
+
+/* Mutator: steal( obj )
+	This mutator (any thread but the owner) removes the front value of the deque and stores
+	it in obj. The value is read before the compare-and-swap on the top that claims it, so
+	the array it was read from may already be retired, but it is still allocated.
+	It returns false if the deque is empty or another thread took the front value first.
+*/
+
+template <typename Type>
+bool Work_stealing_deque<Type>::steal( Type &obj ) {
+
+	std::int64_t top = deque_top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	std::int64_t bottom = deque_bottom.load( std::memory_order_acquire );
+
+	if ( top >= bottom ) return false;
+
+	Ring_array *array = deque_array.load( std::memory_order_acquire );
+	Type value = array->get( top );
+
+	if ( !deque_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+		return false;
+	}
+
+	obj = value;
+	return true;
+}
+
+/* Private member function: grow( array, bottom, top )
+	This function (owner only) copies the values top, ..., bottom - 1 into an array of
+	twice the capacity, publishes it and retires the old array
+*/
+
+template <typename Type>
+typename Work_stealing_deque<Type>::Ring_array *Work_stealing_deque<Type>::grow( Ring_array *array, std::int64_t bottom, std::int64_t top ) {
+
+	Ring_array *array_new = new Ring_array( 2*array->array_capacity, array );
+
+	for ( std::int64_t i = top; i < bottom; ++i ) {
+		array_new->put( i, array->get( i ) );
+	}
+
+	deque_array.store( array_new, std::memory_order_release );
+	return array_new;
+}
+
+template <typename Type>
+Work_stealing_deque<Type>::Ring_array::Ring_array( std::int64_t capacity, Ring_array *retired ):
+array_capacity( capacity ),
+array_values( new std::atomic<Type>[capacity] ),
+retired_array( retired )
+{ }
+
+template <typename Type>
+Work_stealing_deque<Type>::Ring_array::~Ring_array() {
+
+	delete [] array_values;
+}
+
+/* Helper: get( i ) and put( i, obj )
+	These functions read and write the value of counter i, at position i & (capacity - 1)
+*/
+
+template <typename Type>
+Type Work_stealing_deque<Type>::Ring_array::get( std::int64_t i ) const {
+
+	return array_values[i & ( array_capacity - 1 )].load( std::memory_order_relaxed );
+}
+
+template <typename Type>
+void Work_stealing_deque<Type>::Ring_array::put( std::int64_t i, Type obj ) {
+
+	array_values[i & ( array_capacity - 1 )].store( obj, std::memory_order_relaxed );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                        Work_stealing_pool                           //
+/////////////////////////////////////////////////////////////////////////
+
+/* Constructor: Work_stealing_pool( int n )
+	This constructor starts n worker threads (one per hardware thread if n < 1)
+*/
+
+inline Work_stealing_pool::Work_stealing_pool( int n ):
+pool_sleeping( 0 ),
+pool_stop( false )
+{
+	if ( n < 1 ) n = static_cast<int>( std::thread::hardware_concurrency() );
+	if ( n < 1 ) n = 1;
+
+	for ( int i = 0; i < n; ++i ) {
+		pool_deques.push_back( new Work_stealing_deque<Task *>() );
+	}
+	for ( int i = 0; i < n; ++i ) {
+		pool_threads.emplace_back( &Work_stealing_pool::worker_loop, this, i );
+	}
+}
+
+/* Destructor: ~Work_stealing_pool()
+	It stops and joins the worker threads and releases the deques
+*/
+
+inline Work_stealing_pool::~Work_stealing_pool() {
+
+	pool_stop.store( true );
+	{
+		std::lock_guard<std::mutex> lock( pool_mutex );
+		pool_idle.notify_all();
+	}
+
+	for ( std::thread &worker : pool_threads ) {
+		worker.join();
+	}
+	for ( Work_stealing_deque<Task *> *deque : pool_deques ) {
+		delete deque;
+	}
+}
+
+/* Accessor: size()
+	This function returns the number of worker threads
+*/
+
+inline int Work_stealing_pool::size() const {
+
+	return static_cast<int>( pool_threads.size() );
+}
+
+/* Private member function: spawn( task )
+	This function queues a task: on the deque of the calling worker, or on the shared queue
+	if the caller is not a worker of this pool
+*/
+
+inline void Work_stealing_pool::spawn( Task *task ) {
+
+	Worker_context &worker = context();
+
+	if ( worker.pool == this ) {
+		pool_deques[worker.index]->push_back( task );
+	}
+	else {
+		std::lock_guard<std::mutex> lock( pool_mutex );
+		pool_injected.push_back( task );
+	}
+
+	notify();
+}
+
+/* Private member function: run_one()
+	This function finds one task and runs it on the calling thread. It returns false if
+	there was no task to run.
+*/
+
+inline bool Work_stealing_pool::run_one() {
+
+	Task *task = find_task();
+	if ( task == nullptr ) return false;
+
+	execute( task );
+	return true;
+}
+
+/* Private member function: find_task()
+	This function looks for a task in the deque of the calling worker (back), in the
+	shared queue, and in the deques of the other workers (front), starting at a random one.
+	It returns nullptr if no task was found.
+*/
+
+inline Work_stealing_pool::Task *Work_stealing_pool::find_task() {
+
+	Worker_context &worker = context();
+	int n = static_cast<int>( pool_deques.size() );
+	int self = ( worker.pool == this ) ? worker.index : -1;
+	Task *task = nullptr;
+
+	if ( self >= 0 and pool_deques[self]->pop_back( task ) ) return task;
+
+	{
+		std::lock_guard<std::mutex> lock( pool_mutex );
+		if ( !pool_injected.empty() ) {
+			task = pool_injected.front();
+			pool_injected.pop_front();
+			return task;
+		}
+	}
+
+	// xorshift32
+	std::uint32_t &random = worker.random_state;
+	random ^= random << 13;
+	random ^= random >> 17;
+	random ^= random << 5;
+
+	int start = static_cast<int>( random % n );
+	for ( int i = 0; i < n; ++i ) {
+		int victim = ( start + i ) % n;
+		if ( victim != self and pool_deques[victim]->steal( task ) ) return task;
+	}
+
+	return nullptr;
+}
+
+/* Private member function: execute( task )
+	This function runs a task, reports its completion (or exception) to its group and deletes it
+*/
+
+inline void Work_stealing_pool::execute( Task *task ) {
+
+	std::exception_ptr exception;
+	try {
+		task->task_function();
+	}
+	catch ( ... ) {
+		exception = std::current_exception();
+	}
+
+	Task_group *group = task->task_group;
+	delete task;
+	group->finish( exception );
+}
+
+/* Private member function: notify()
+	This function wakes one sleeping worker, if there is one, after a task has been queued
+*/
+
+inline void Work_stealing_pool::notify() {
+
+	if ( pool_sleeping.load( std::memory_order_acquire ) > 0 ) {
+		std::lock_guard<std::mutex> lock( pool_mutex );
+		pool_idle.notify_one();
+	}
+}
+
+/* Private member function: worker_loop( index )
+	This function is run by worker thread index until the pool is destroyed. It runs tasks
+	while it can find them, and sleeps after SPIN_ROUNDS failed attempts.
+*/
+
+inline void Work_stealing_pool::worker_loop( int index ) {
+
+	Worker_context &worker = context();
+	worker.pool = this;
+	worker.index = index;
+	worker.random_state = 2463534242u + 7919u*static_cast<std::uint32_t>( index );
+
+	int failures = 0;
+	while ( !pool_stop.load( std::memory_order_relaxed ) ) {
+		if ( run_one() ) {
+			failures = 0;
+		}
+		else if ( ++failures < SPIN_ROUNDS ) {
+			std::this_thread::yield();
+		}
+		else {
+			std::unique_lock<std::mutex> lock( pool_mutex );
+			pool_sleeping.fetch_add( 1 );
+			if ( pool_injected.empty() and !pool_stop.load() ) {
+				pool_idle.wait_for( lock, std::chrono::milliseconds( 1 ) );
+			}
+			pool_sleeping.fetch_sub( 1 );
+			failures = 0;
+		}
+	}
+}
+
+/* Private member function: context()
+	This function returns the worker context of the calling thread; its pool is nullptr
+	if the thread is not a worker thread
+*/
+
+inline Work_stealing_pool::Worker_context &Work_stealing_pool::context() {
+
+	static thread_local Worker_context worker = { nullptr, -1, 2463534242u };
+	return worker;
+}
+
+inline Work_stealing_pool::Task::Task( std::function<void()> &&function, Task_group *group ):
+task_function( std::move( function ) ),
+task_group( group )
+{ }
+
+/////////////////////////////////////////////////////////////////////////
+//                            Task_group                               //
+/////////////////////////////////////////////////////////////////////////
+
+inline Task_group::Task_group( Work_stealing_pool &pool ):
+group_pool( pool ),
+group_pending( 0 )
+{ }
+
+/* Destructor: ~Task_group()
+	It waits for the tasks that are still running (without rethrowing their exception)
+*/
+
+inline Task_group::~Task_group() {
+
+	while ( group_pending.load( std::memory_order_acquire ) > 0 ) {
+		if ( !group_pool.run_one() ) std::this_thread::yield();
+	}
+}
+
+/* Mutator: run( function )
+	This mutator forks a task that calls function()
+*/
+
+template <typename Function>
+void Task_group::run( Function &&function ) {
+
+	Work_stealing_pool::Task *task = new Work_stealing_pool::Task( std::function<void()>( std::forward<Function>( function ) ), this );
+
+	group_pending.fetch_add( 1, std::memory_order_relaxed );
+	try {
+		group_pool.spawn( task );
+	}
+	catch ( ... ) {
+		group_pending.fetch_sub( 1, std::memory_order_relaxed );
+		delete task;
+		throw;
+	}
+}
+
+/* Mutator: wait()
+	This mutator runs tasks of the pool until every task of the group has finished, then
+	rethrows the first exception thrown by a task of the group, if any
+*/
+
+inline void Task_group::wait() {
+
+	while ( group_pending.load( std::memory_order_acquire ) > 0 ) {
+		if ( !group_pool.run_one() ) std::this_thread::yield();
+	}
+
+	std::exception_ptr exception;
+	{
+		std::lock_guard<std::mutex> lock( group_mutex );
+		std::swap( exception, group_exception );
+	}
+	if ( exception ) std::rethrow_exception( exception );
+}
+
+/* Private member function: finish( exception )
+	This function records the end of one task of the group
+*/
+
+inline void Task_group::finish( std::exception_ptr exception ) {
+
+	if ( exception ) {
+		std::lock_guard<std::mutex> lock( group_mutex );
+		if ( !group_exception ) group_exception = exception;
+	}
+
+	group_pending.fetch_sub( 1, std::memory_order_release );
+}
+
+#endif
@@ -0,0 +1,173 @@
+// Fork/join benchmark of Work_stealing_pool (and of the Work_stealing_deque it is built on):
+// parallel fib and parallel sum, compared with the same computation on one thread.
+//
+// Build:	g++ -std=c++17 -O2 -pthread 2_Work_stealing_deque_benchmark.cpp -o steal_benchmark
+// Run:		./steal_benchmark [fib n (default 36)] [sum size (default 100000000)] [maximum threads (default all cores)]
+//
+// fib	fib( n ) = fib( n - 1 ) + fib( n - 2 ), forking fib( n - 1 ) as a task down to
+//	FIB_CUTOFF, below which it recurses serially
+// sum	the sum of a vector, split in two halves (one of them forked) down to SUM_GRAIN values
+// Both are run on pools of 1, 2, 4, ... threads; the time is the best of three runs and the
+// speedup is relative to the serial version. The owner test measures the nanoseconds of a
+// push_back/pop_back pair on a Work_stealing_deque that no thread steals from, next to
+// Resizable_deque.
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The exceptions thrown by the deques
+class underflow {};
+class overflow {};
+class illegal_argument {};
+
+#include "2_Resizable_deque.h"
+#include "2_Work_stealing_deque.h"
+
+static int const FIB_CUTOFF = 20;
+static long const SUM_GRAIN = 1 << 16;
+
+static double elapsed( std::chrono::steady_clock::time_point start ) {
+	return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Keeps the compiler from dropping the results
+static volatile std::int64_t sink;
+
+static std::int64_t serial_fib( int n ) {
+	return ( n < 2 ) ? n : serial_fib( n - 1 ) + serial_fib( n - 2 );
+}
+
+static std::int64_t parallel_fib( Work_stealing_pool &pool, int n ) {
+	if ( n < FIB_CUTOFF ) return serial_fib( n );
+
+	std::int64_t left;
+	Task_group group( pool );
+	group.run( [&]{ left = parallel_fib( pool, n - 1 ); } );
+	std::int64_t right = parallel_fib( pool, n - 2 );
+	group.wait();
+
+	return left + right;
+}
+
+static std::int64_t serial_sum( std::int64_t const *first, std::int64_t const *last ) {
+	return std::accumulate( first, last, std::int64_t( 0 ) );
+}
+
+static std::int64_t parallel_sum( Work_stealing_pool &pool, std::int64_t const *first, std::int64_t const *last ) {
+	if ( last - first <= SUM_GRAIN ) return serial_sum( first, last );
+
+	std::int64_t const *middle = first + ( last - first )/2;
+	std::int64_t left;
+	Task_group group( pool );
+	group.run( [&]{ left = parallel_sum( pool, first, middle ); } );
+	std::int64_t right = parallel_sum( pool, middle, last );
+	group.wait();
+
+	return left + right;
+}
+
+template <typename Test>
+double best_of_three( Test test ) {
+	double best = 1e300;
+
+	for ( int i = 0; i < 3; ++i ) {
+		auto start = std::chrono::steady_clock::now();
+		sink = test();
+		best = std::min( best, elapsed( start ) );
+	}
+
+	return best;
+}
+
+/*
+	owner_test returns the nanoseconds per push_back/pop_back pair on deque, keeping
+	depth values in it
+*/
+template <typename Deque>
+double owner_test( Deque &deque, long count, int depth ) {
+	for ( int i = 0; i < depth; ++i ) deque.push_back( i );
+
+	std::int64_t sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( long i = 0; i < count; ++i ) {
+		deque.push_back( i );
+		std::int64_t value;
+		if ( !deque.pop_back( value ) ) break;
+		sum += value;
+	}
+
+	double ns = elapsed( start )*1e9/count;
+	sink = sum;
+	return ns;
+}
+
+/*
+	Resizable_deque_adapter gives Resizable_deque the pop_back( obj ) of Work_stealing_deque
+*/
+class Resizable_deque_adapter {
+	public:
+		void push_back( std::int64_t value ) { deque.push_back( value ); }
+
+		bool pop_back( std::int64_t &value ) {
+			if ( deque.empty() ) return false;
+			value = deque.back();
+			deque.pop_back();
+			return true;
+		}
+
+	private:
+		Resizable_deque<std::int64_t> deque;
+};
+
+static void print( std::string const &name, std::string const &threads, double seconds, double serial ) {
+	std::cout << std::left << std::setw( 8 ) << name << std::right << std::setw( 8 ) << threads
+	          << std::setw( 12 ) << std::fixed << std::setprecision( 4 ) << seconds
+	          << std::setw( 10 ) << std::setprecision( 2 ) << serial/seconds << std::endl;
+}
+
+int main( int argc, char **argv ) {
+	int fib_n = ( argc > 1 ) ? std::atoi( argv[1] ) : 36;
+	long sum_size = ( argc > 2 ) ? std::atol( argv[2] ) : 100000000;
+	int max_threads = ( argc > 3 ) ? std::atoi( argv[3] ) : static_cast<int>( std::thread::hardware_concurrency() );
+	max_threads = std::max( max_threads, 1 );
+
+	std::vector<std::int64_t> values( sum_size );
+	std::iota( values.begin(), values.end(), std::int64_t( 0 ) );
+	std::int64_t const *first = values.data();
+	std::int64_t const *last = values.data() + values.size();
+
+	std::cout << std::left << std::setw( 8 ) << "test" << std::right << std::setw( 8 ) << "threads"
+	          << std::setw( 12 ) << "seconds" << std::setw( 10 ) << "speedup" << std::endl;
+
+	double serial_fib_time = best_of_three( [&]{ return serial_fib( fib_n ); } );
+	double serial_sum_time = best_of_three( [&]{ return serial_sum( first, last ); } );
+	print( "fib", "serial", serial_fib_time, serial_fib_time );
+	print( "sum", "serial", serial_sum_time, serial_sum_time );
+
+	for ( int threads = 1; threads <= max_threads; threads *= 2 ) {
+		Work_stealing_pool pool( threads );
+		print( "fib", std::to_string( threads ), best_of_three( [&]{ return parallel_fib( pool, fib_n ); } ), serial_fib_time );
+		print( "sum", std::to_string( threads ), best_of_three( [&]{ return parallel_sum( pool, first, last ); } ), serial_sum_time );
+	}
+
+	std::cout << std::endl;
+
+	long count = 10000000;
+	Work_stealing_deque<std::int64_t> stealing;
+	Resizable_deque_adapter resizable;
+	std::cout << "owner push_back/pop_back, ns per pair" << std::endl
+	          << std::left << std::setw( 22 ) << "Work_stealing_deque" << std::right << std::fixed << std::setprecision( 2 )
+	          << std::setw( 10 ) << owner_test( stealing, count, 16 ) << std::endl
+	          << std::left << std::setw( 22 ) << "Resizable_deque" << std::right
+	          << std::setw( 10 ) << owner_test( resizable, count, 16 ) << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,735 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+// A B+-tree with the interface of Search_tree. The values are stored in sorted arrays in
+// the leaves, which are linked in order between two sentinel leaves, and the internal
+// nodes only hold copies of values that separate their children. A node takes about
+// NodeBytes bytes, so a lookup touches one node (a few cache lines) per level, and an
+// in-order traversal scans the arrays of consecutive leaves.
+// Type must be default constructible and ordered by <.
+// Unlike Search_tree, whose iterators point to nodes that only move when they are erased,
+// an iterator here is a (leaf, position) pair: any insert or erase may shift the values of
+// a leaf, split it, merge it or move values between siblings, so it invalidates all the
+// iterators of the tree, including those of values it did not touch.
+
+// The number of values of per_value bytes that fit in bytes (at least 3)
+inline constexpr int btree_node_capacity( int bytes, int per_value ) {
+	return ( bytes/per_value < 3 ) ? 3 : bytes/per_value;
+}
+
+template <typename Type, int NodeBytes = 256>
+class Btree_search_tree {
+	public:
+		class Iterator;
+
+	private:
+		class Node {
+			public:
+				int key_count;
+				bool is_leaf;
+
+				Node( bool leaf ): key_count( 0 ), is_leaf( leaf ) {}
+		};
+
+	public:
+		static constexpr int leaf_capacity =
+			btree_node_capacity( NodeBytes - static_cast<int>( sizeof( Node ) + 2*sizeof( void * ) ), static_cast<int>( sizeof( Type ) ) );
+		static constexpr int branch_capacity =
+			btree_node_capacity( NodeBytes - static_cast<int>( sizeof( Node ) + sizeof( void * ) ), static_cast<int>( sizeof( Type ) + sizeof( void * ) ) );
+
+	private:
+		class Leaf : public Node {
+			public:
+				Leaf *previous_leaf;
+				Leaf *next_leaf;
+				Type keys[leaf_capacity];
+
+				Leaf(): Node( true ), previous_leaf( nullptr ), next_leaf( nullptr ) {}
+		};
+
+		// children[i] holds the values v with keys[i - 1] <= v < keys[i]
+		class Branch : public Node {
+			public:
+				Type keys[branch_capacity];
+				Node *children[branch_capacity + 1];
+
+				Branch(): Node( false ) {}
+		};
+
+		// A node other than the root is at least about half full: these are the sizes of the
+		// smaller half of a split (the middle key of a branch moves up to its parent)
+		static constexpr int leaf_minimum = leaf_capacity/2;
+		static constexpr int branch_minimum = ( branch_capacity - 1 )/2;
+		// Every internal node has at least two children, so 2^31 values fit in 32 levels
+		static int const max_depth = 64;
+
+		Node *root_node;
+		int tree_size;
+		int tree_height;
+		Leaf *front_sentinel;
+		Leaf *back_sentinel;
+
+		static int child_index( Branch const *branch, Type const &obj );
+		static void insert_key( Leaf *leaf, int position, Type const &obj );
+		static void insert_child( Branch *branch, int position, Type const &key, Node *right );
+		static void remove_child( Branch *branch, int position );
+		static void split_leaf( Leaf *leaf, Leaf *new_leaf );
+		static void split_branch( Branch *branch, Branch *new_branch, Type &promoted );
+		void fix_leaf( Branch *parent, int position );
+		void fix_branch( Branch *parent, int position );
+		Leaf *find_leaf( Type const &obj ) const;
+
+	public:
+		class Iterator {
+			private:
+				Btree_search_tree *containing_tree;
+				Leaf *current_leaf;
+				int current_index;
+
+				// The constructor is private so that only the search tree can create an iterator
+				Iterator( Btree_search_tree *tree, Leaf *starting_leaf, int starting_index );
+
+			public:
+				Type operator*() const;
+				Iterator &operator++();
+				Iterator &operator--();
+				bool operator==( Iterator const &rhs ) const;
+				bool operator!=( Iterator const &rhs ) const;
+
+			friend class Btree_search_tree;
+		};
+
+		Btree_search_tree();
+		Btree_search_tree( Btree_search_tree const & ) = delete;
+		Btree_search_tree &operator=( Btree_search_tree const & ) = delete;
+		~Btree_search_tree();
+
+		bool empty() const;
+		int size() const;
+		int height() const;
+
+		Type front() const;
+		Type back() const;
+
+		Iterator begin();
+		Iterator end();
+		Iterator rbegin();
+		Iterator rend();
+		Iterator find( Type const & );
+
+		// Range queries: the iterators are positioned in the linked leaves
+		Iterator lower_bound( Type const & );
+		Iterator upper_bound( Type const & );
+		std::pair<Iterator, Iterator> equal_range( Type const & );
+		template <typename Function>
+		void for_each_in_range( Type const &, Type const &, Function ) const;
+
+		void clear();
+		bool insert( Type const & );
+		bool erase( Type const & );
+
+};
+
+//////////////////////////////////////////////////////////////////////
+//            B+-tree Search Tree Public Member Functions           //
+//////////////////////////////////////////////////////////////////////
+
+template <typename Type, int NodeBytes>
+Btree_search_tree<Type, NodeBytes>::Btree_search_tree():
+root_node( nullptr ),
+tree_size( 0 ),
+tree_height( -1 ),
+front_sentinel( new Leaf() ),
+back_sentinel( new Leaf() ) {
+	front_sentinel->next_leaf = back_sentinel;
+	back_sentinel->previous_leaf = front_sentinel;
+}
+
+template <typename Type, int NodeBytes>
+Btree_search_tree<Type, NodeBytes>::~Btree_search_tree() {
+	clear();
+	delete front_sentinel;
+	delete back_sentinel;
+}
+
+template <typename Type, int NodeBytes>
+bool Btree_search_tree<Type, NodeBytes>::empty() const {
+	return ( root_node == nullptr );
+}
+
+template <typename Type, int NodeBytes>
+int Btree_search_tree<Type, NodeBytes>::size() const {
+	return tree_size;
+}
+
+// The number of levels below the root: -1 if the tree is empty, 0 if the root is a leaf
+template <typename Type, int NodeBytes>
+int Btree_search_tree<Type, NodeBytes>::height() const {
+	return tree_height;
+}
+
+template <typename Type, int NodeBytes>
+Type Btree_search_tree<Type, NodeBytes>::front() const {
+	if ( empty() ) {
+		throw underflow();
+	}
+
+	return front_sentinel->next_leaf->keys[0];
+}
+
+template <typename Type, int NodeBytes>
+Type Btree_search_tree<Type, NodeBytes>::back() const {
+	if ( empty() ) {
+		throw underflow();
+	}
+
+	Leaf *last = back_sentinel->previous_leaf;
+	return last->keys[last->key_count - 1];
+}
+
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::begin() {
+	return Iterator( this, front_sentinel->next_leaf, 0 );
+}
+
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::end() {
+	return Iterator( this, back_sentinel, 0 );
+}
+
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::rbegin() {
+	Leaf *last = back_sentinel->previous_leaf;
+	return ( last == front_sentinel ) ? rend() : Iterator( this, last, last->key_count - 1 );
+}
+
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::rend() {
+	return Iterator( this, front_sentinel, 0 );
+}
+
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::find( Type const &obj ) {
+	if ( empty() ) {
+		return end();
+	}
+
+	Leaf *leaf = find_leaf( obj );
+	int position = std::lower_bound( leaf->keys, leaf->keys + leaf->key_count, obj ) - leaf->keys;
+
+	if ( position < leaf->key_count && !( obj < leaf->keys[position] ) ) {
+		return Iterator( this, leaf, position );
+	} else {
+		return end();
+	}
+}
+
+// Return an iterator to the first element not less than obj, or end() if there is none.
+// The elements of the leaf of obj that follow it, then those of the next leaves, are the
+// elements greater than obj
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::lower_bound( Type const &obj ) {
+	if ( empty() ) {
+		return end();
+	}
+
+	Leaf *leaf = find_leaf( obj );
+	int position = std::lower_bound( leaf->keys, leaf->keys + leaf->key_count, obj ) - leaf->keys;
+
+	return ( position < leaf->key_count ) ? Iterator( this, leaf, position ) : Iterator( this, leaf->next_leaf, 0 );
+}
+
+// Return an iterator to the first element greater than obj, or end() if there is none
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator Btree_search_tree<Type, NodeBytes>::upper_bound( Type const &obj ) {
+	if ( empty() ) {
+		return end();
+	}
+
+	Leaf *leaf = find_leaf( obj );
+	int position = std::upper_bound( leaf->keys, leaf->keys + leaf->key_count, obj ) - leaf->keys;
+
+	return ( position < leaf->key_count ) ? Iterator( this, leaf, position ) : Iterator( this, leaf->next_leaf, 0 );
+}
+
+// Return the range of elements equal to obj (empty, or the one element equal to obj)
+template <typename Type, int NodeBytes>
+std::pair<typename Btree_search_tree<Type, NodeBytes>::Iterator, typename Btree_search_tree<Type, NodeBytes>::Iterator> Btree_search_tree<Type, NodeBytes>::equal_range( Type const &obj ) {
+	Iterator first = lower_bound( obj );
+	Iterator last = first;
+
+	if ( first != end() && !( obj < *first ) ) {
+		++last;
+	}
+
+	return std::make_pair( first, last );
+}
+
+// Call f( x ) for each element x with lo <= x <= hi, in order: one descent to the leaf of
+// lo, then a scan of the arrays of the linked leaves
+template <typename Type, int NodeBytes>
+template <typename Function>
+void Btree_search_tree<Type, NodeBytes>::for_each_in_range( Type const &lo, Type const &hi, Function f ) const {
+	if ( empty() ) {
+		return;
+	}
+
+	Leaf const *leaf = find_leaf( lo );
+	int position = std::lower_bound( leaf->keys, leaf->keys + leaf->key_count, lo ) - leaf->keys;
+
+	for ( ; leaf != back_sentinel; leaf = leaf->next_leaf, position = 0 ) {
+		for ( ; position < leaf->key_count; ++position ) {
+			if ( hi < leaf->keys[position] ) {
+				return;
+			}
+
+			f( leaf->keys[position] );
+		}
+	}
+}
+
+// Delete the nodes without recursion, keeping the path to the current node
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::clear() {
+	Branch *path[max_depth];
+	int next_child[max_depth];
+	int depth = 0;
+	Node *curr_node = root_node;
+
+	while ( curr_node != nullptr ) {
+		if ( !curr_node->is_leaf ) {
+			path[depth] = static_cast<Branch *>( curr_node );
+			next_child[depth] = 1;
+			curr_node = path[depth++]->children[0];
+			continue;
+		}
+
+		delete static_cast<Leaf *>( curr_node );
+		curr_node = nullptr;
+
+		// Go up to the deepest branch with a child left to visit, deleting the finished ones
+		while ( depth > 0 && curr_node == nullptr ) {
+			Branch *branch = path[depth - 1];
+
+			if ( next_child[depth - 1] <= branch->key_count ) {
+				curr_node = branch->children[next_child[depth - 1]++];
+			} else {
+				delete branch;
+				--depth;
+			}
+		}
+	}
+
+	root_node = nullptr;
+	tree_size = 0;
+	tree_height = -1;
+
+	// Reinitialize the sentinels
+	front_sentinel->next_leaf = back_sentinel;
+	back_sentinel->previous_leaf = front_sentinel;
+}
+
+// Insert obj in its leaf. A full leaf is split in two, which adds a separator and a child
+// to its parent; a full parent is split in turn, up the path, and a split root adds a level.
+// The nodes for all the splits are allocated before anything is changed, so if an
+// allocation throws, the tree is left unchanged
+template <typename Type, int NodeBytes>
+bool Btree_search_tree<Type, NodeBytes>::insert( Type const &obj ) {
+	if ( empty() ) {
+		Leaf *leaf = new Leaf();
+		leaf->keys[0] = obj;
+		leaf->key_count = 1;
+		leaf->previous_leaf = front_sentinel;
+		leaf->next_leaf = back_sentinel;
+		front_sentinel->next_leaf = leaf;
+		back_sentinel->previous_leaf = leaf;
+
+		root_node = leaf;
+		tree_size = 1;
+		tree_height = 0;
+		return true;
+	}
+
+	Branch *path[max_depth];
+	int slot[max_depth];
+	int depth = 0;
+	Node *curr_node = root_node;
+
+	while ( !curr_node->is_leaf ) {
+		Branch *branch = static_cast<Branch *>( curr_node );
+		path[depth] = branch;
+		slot[depth] = child_index( branch, obj );
+		curr_node = branch->children[slot[depth++]];
+	}
+
+	Leaf *leaf = static_cast<Leaf *>( curr_node );
+	int position = std::lower_bound( leaf->keys, leaf->keys + leaf->key_count, obj ) - leaf->keys;
+
+	if ( position < leaf->key_count && !( obj < leaf->keys[position] ) ) {
+		return false;
+	}
+
+	if ( leaf->key_count < leaf_capacity ) {
+		insert_key( leaf, position, obj );
+		++tree_size;
+		return true;
+	}
+
+	// The full branches just above the leaf are split too, and so is the root if they all are
+	int full = 0;
+
+	while ( full < depth && path[depth - 1 - full]->key_count == branch_capacity ) {
+		++full;
+	}
+
+	int needed = ( full == depth ) ? full + 1 : full;
+	Branch *new_branches[max_depth + 1];
+	int allocated = 0;
+	Leaf *new_leaf = new Leaf();
+
+	try {
+		for ( ; allocated < needed; ++allocated ) {
+			new_branches[allocated] = new Branch();
+		}
+	} catch (...) {
+		while ( allocated > 0 ) {
+			delete new_branches[--allocated];
+		}
+
+		delete new_leaf;
+		throw;
+	}
+
+	int used = 0;
+	split_leaf( leaf, new_leaf );
+
+	if ( position <= leaf->key_count ) {
+		insert_key( leaf, position, obj );
+	} else {
+		insert_key( new_leaf, position - leaf->key_count, obj );
+	}
+
+	Type separator = new_leaf->keys[0];
+	Node *right = new_leaf;
+
+	while ( depth > 0 ) {
+		Branch *parent = path[--depth];
+		int child = slot[depth];
+
+		if ( parent->key_count < branch_capacity ) {
+			insert_child( parent, child, separator, right );
+			++tree_size;
+			return true;
+		}
+
+		Type promoted;
+		Branch *new_branch = new_branches[used++];
+		split_branch( parent, new_branch, promoted );
+
+		if ( child <= parent->key_count ) {
+			insert_child( parent, child, separator, right );
+		} else {
+			insert_child( new_branch, child - parent->key_count - 1, separator, right );
+		}
+
+		separator = std::move( promoted );
+		right = new_branch;
+	}
+
+	// The root was split
+	Branch *new_root = new_branches[used];
+	new_root->keys[0] = std::move( separator );
+	new_root->children[0] = root_node;
+	new_root->children[1] = right;
+	new_root->key_count = 1;
+	root_node = new_root;
+	++tree_height;
+	++tree_size;
+
+	return true;
+}
+
+// Erase obj from its leaf. A leaf (or branch) left with fewer than half of its capacity
+// borrows a value from a sibling, or is merged with it, which removes a child from its
+// parent, up the path; a root branch left with a single child is removed
+template <typename Type, int NodeBytes>
+bool Btree_search_tree<Type, NodeBytes>::erase( Type const &obj ) {
+	if ( empty() ) {
+		return false;
+	}
+
+	Branch *path[max_depth];
+	int slot[max_depth];
+	int depth = 0;
+	Node *curr_node = root_node;
+
+	while ( !curr_node->is_leaf ) {
+		Branch *branch = static_cast<Branch *>( curr_node );
+		path[depth] = branch;
+		slot[depth] = child_index( branch, obj );
+		curr_node = branch->children[slot[depth++]];
+	}
+
+	Leaf *leaf = static_cast<Leaf *>( curr_node );
+	int position = std::lower_bound( leaf->keys, leaf->keys + leaf->key_count, obj ) - leaf->keys;
+
+	if ( position == leaf->key_count || obj < leaf->keys[position] ) {
+		return false;
+	}
+
+	std::move( leaf->keys + position + 1, leaf->keys + leaf->key_count, leaf->keys + position );
+	--leaf->key_count;
+	--tree_size;
+
+	if ( depth == 0 ) {
+		if ( leaf->key_count == 0 ) {
+			front_sentinel->next_leaf = back_sentinel;
+			back_sentinel->previous_leaf = front_sentinel;
+			delete leaf;
+			root_node = nullptr;
+			tree_height = -1;
+		}
+
+		return true;
+	}
+
+	if ( leaf->key_count >= leaf_minimum ) {
+		return true;
+	}
+
+	fix_leaf( path[depth - 1], slot[depth - 1] );
+
+	while ( --depth > 0 && path[depth]->key_count < branch_minimum ) {
+		fix_branch( path[depth - 1], slot[depth - 1] );
+	}
+
+	if ( root_node != nullptr && !root_node->is_leaf && root_node->key_count == 0 ) {
+		Branch *old_root = static_cast<Branch *>( root_node );
+		root_node = old_root->children[0];
+		delete old_root;
+		--tree_height;
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+//           B+-tree Search Tree Private Member Functions           //
+//////////////////////////////////////////////////////////////////////
+
+// The leaf whose values include obj, in a tree that is not empty
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Leaf *Btree_search_tree<Type, NodeBytes>::find_leaf( Type const &obj ) const {
+	Node *curr_node = root_node;
+
+	while ( !curr_node->is_leaf ) {
+		Branch *branch = static_cast<Branch *>( curr_node );
+		curr_node = branch->children[child_index( branch, obj )];
+	}
+
+	return static_cast<Leaf *>( curr_node );
+}
+
+// The child of branch whose values include obj
+template <typename Type, int NodeBytes>
+int Btree_search_tree<Type, NodeBytes>::child_index( Branch const *branch, Type const &obj ) {
+	return std::upper_bound( branch->keys, branch->keys + branch->key_count, obj ) - branch->keys;
+}
+
+// Insert obj at the given position of a leaf that is not full
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::insert_key( Leaf *leaf, int position, Type const &obj ) {
+	std::move_backward( leaf->keys + position, leaf->keys + leaf->key_count, leaf->keys + leaf->key_count + 1 );
+	leaf->keys[position] = obj;
+	++leaf->key_count;
+}
+
+// Insert a separator at keys[position] and the child on its right at children[position + 1]
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::insert_child( Branch *branch, int position, Type const &key, Node *right ) {
+	std::move_backward( branch->keys + position, branch->keys + branch->key_count, branch->keys + branch->key_count + 1 );
+	std::move_backward( branch->children + position + 1, branch->children + branch->key_count + 1, branch->children + branch->key_count + 2 );
+	branch->keys[position] = key;
+	branch->children[position + 1] = right;
+	++branch->key_count;
+}
+
+// Remove keys[position] and children[position + 1]
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::remove_child( Branch *branch, int position ) {
+	std::move( branch->keys + position + 1, branch->keys + branch->key_count, branch->keys + position );
+	std::move( branch->children + position + 2, branch->children + branch->key_count + 1, branch->children + position + 1 );
+	--branch->key_count;
+}
+
+// Move the upper half of a full leaf to the empty new_leaf, and link it after the leaf
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::split_leaf( Leaf *leaf, Leaf *new_leaf ) {
+	int half = leaf->key_count/2;
+
+	std::move( leaf->keys + half, leaf->keys + leaf->key_count, new_leaf->keys );
+	new_leaf->key_count = leaf->key_count - half;
+	leaf->key_count = half;
+
+	new_leaf->previous_leaf = leaf;
+	new_leaf->next_leaf = leaf->next_leaf;
+	leaf->next_leaf->previous_leaf = new_leaf;
+	leaf->next_leaf = new_leaf;
+}
+
+// Move the keys and children above the middle key of a full branch to the empty new_branch;
+// the middle key, which separates the two branches, is moved to promoted
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::split_branch( Branch *branch, Branch *new_branch, Type &promoted ) {
+	int middle = branch->key_count/2;
+
+	std::move( branch->keys + middle + 1, branch->keys + branch->key_count, new_branch->keys );
+	std::move( branch->children + middle + 1, branch->children + branch->key_count + 1, new_branch->children );
+	new_branch->key_count = branch->key_count - middle - 1;
+	promoted = std::move( branch->keys[middle] );
+	branch->key_count = middle;
+}
+
+// The leaf parent->children[position] has too few values: borrow one from a sibling that
+// can spare it, or else merge the leaf with a sibling
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::fix_leaf( Branch *parent, int position ) {
+	Leaf *leaf = static_cast<Leaf *>( parent->children[position] );
+	Leaf *left = ( position > 0 ) ? static_cast<Leaf *>( parent->children[position - 1] ) : nullptr;
+	Leaf *right = ( position < parent->key_count ) ? static_cast<Leaf *>( parent->children[position + 1] ) : nullptr;
+
+	if ( left != nullptr && left->key_count > leaf_minimum ) {
+		insert_key( leaf, 0, left->keys[left->key_count - 1] );
+		--left->key_count;
+		parent->keys[position - 1] = leaf->keys[0];
+	} else if ( right != nullptr && right->key_count > leaf_minimum ) {
+		leaf->keys[leaf->key_count++] = std::move( right->keys[0] );
+		std::move( right->keys + 1, right->keys + right->key_count, right->keys );
+		--right->key_count;
+		parent->keys[position] = right->keys[0];
+	} else {
+		// Merge the right one of the two leaves into the left one
+		if ( left != nullptr ) {
+			right = leaf;
+			leaf = left;
+			--position;
+		}
+
+		std::move( right->keys, right->keys + right->key_count, leaf->keys + leaf->key_count );
+		leaf->key_count += right->key_count;
+		leaf->next_leaf = right->next_leaf;
+		right->next_leaf->previous_leaf = leaf;
+		delete right;
+		remove_child( parent, position );
+	}
+}
+
+// The branch parent->children[position] has too few keys: rotate a key and a child
+// through the parent from a sibling that can spare them, or else merge the branch,
+// the separator in the parent and a sibling
+template <typename Type, int NodeBytes>
+void Btree_search_tree<Type, NodeBytes>::fix_branch( Branch *parent, int position ) {
+	Branch *branch = static_cast<Branch *>( parent->children[position] );
+	Branch *left = ( position > 0 ) ? static_cast<Branch *>( parent->children[position - 1] ) : nullptr;
+	Branch *right = ( position < parent->key_count ) ? static_cast<Branch *>( parent->children[position + 1] ) : nullptr;
+
+	if ( left != nullptr && left->key_count > branch_minimum ) {
+		std::move_backward( branch->keys, branch->keys + branch->key_count, branch->keys + branch->key_count + 1 );
+		std::move_backward( branch->children, branch->children + branch->key_count + 1, branch->children + branch->key_count + 2 );
+		branch->keys[0] = std::move( parent->keys[position - 1] );
+		branch->children[0] = left->children[left->key_count];
+		++branch->key_count;
+		parent->keys[position - 1] = std::move( left->keys[left->key_count - 1] );
+		--left->key_count;
+	} else if ( right != nullptr && right->key_count > branch_minimum ) {
+		branch->keys[branch->key_count] = std::move( parent->keys[position] );
+		branch->children[branch->key_count + 1] = right->children[0];
+		++branch->key_count;
+		parent->keys[position] = std::move( right->keys[0] );
+		std::move( right->keys + 1, right->keys + right->key_count, right->keys );
+		std::move( right->children + 1, right->children + right->key_count + 1, right->children );
+		--right->key_count;
+	} else {
+		// Merge the right one of the two branches into the left one
+		if ( left != nullptr ) {
+			right = branch;
+			branch = left;
+			--position;
+		}
+
+		branch->keys[branch->key_count] = std::move( parent->keys[position] );
+		std::move( right->keys, right->keys + right->key_count, branch->keys + branch->key_count + 1 );
+		std::move( right->children, right->children + right->key_count + 1, branch->children + branch->key_count + 1 );
+		branch->key_count += right->key_count + 1;
+		delete right;
+		remove_child( parent, position );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+//                   Iterator Private Constructor                   //
+//////////////////////////////////////////////////////////////////////
+
+template <typename Type, int NodeBytes>
+Btree_search_tree<Type, NodeBytes>::Iterator::Iterator( Btree_search_tree<Type, NodeBytes> *tree, Leaf *starting_leaf, int starting_index ):
+containing_tree( tree ),
+current_leaf( starting_leaf ),
+current_index( starting_index ) {
+	// Does nothing...
+}
+
+//////////////////////////////////////////////////////////////////////
+//                 Iterator Public Member Functions                 //
+//////////////////////////////////////////////////////////////////////
+
+template <typename Type, int NodeBytes>
+Type Btree_search_tree<Type, NodeBytes>::Iterator::operator*() const {
+
+	return current_leaf->keys[current_index];
+}
+
+// Move to the next value in the leaf, or to the first value of the next leaf
+// If we are already at end do nothing
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator &Btree_search_tree<Type, NodeBytes>::Iterator::operator++() {
+
+	if ( current_leaf == containing_tree->back_sentinel ) {
+
+	} else if ( current_leaf == containing_tree->front_sentinel || ++current_index == current_leaf->key_count ) {
+		current_leaf = current_leaf->next_leaf;
+		current_index = 0;
+	}
+
+	return *this;
+}
+
+// Move to the previous value in the leaf, or to the last value of the previous leaf
+// If we are already at rend do nothing
+template <typename Type, int NodeBytes>
+typename Btree_search_tree<Type, NodeBytes>::Iterator &Btree_search_tree<Type, NodeBytes>::Iterator::operator--() {
+
+	if ( current_leaf == containing_tree->front_sentinel ) {
+
+	} else if ( current_index > 0 ) {
+		--current_index;
+	} else {
+		current_leaf = current_leaf->previous_leaf;
+		current_index = ( current_leaf == containing_tree->front_sentinel ) ? 0 : current_leaf->key_count - 1;
+	}
+
+	return *this;
+}
+
+template <typename Type, int NodeBytes>
+bool Btree_search_tree<Type, NodeBytes>::Iterator::operator==( typename Btree_search_tree<Type, NodeBytes>::Iterator const &rhs ) const {
+
+	return ( current_leaf == rhs.current_leaf && current_index == rhs.current_index );
+}
+
+template <typename Type, int NodeBytes>
+bool Btree_search_tree<Type, NodeBytes>::Iterator::operator!=( typename Btree_search_tree<Type, NodeBytes>::Iterator const &rhs ) const {
+
+	return !( *this == rhs );
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cassert>
+#include <utility>
 
 template <typename Type>
 class Search_tree {
@@ -11,6 +12,8 @@ class Search_tree {
 			public:
 				Type node_value;
 				int tree_height;
+				// The number of nodes in the sub-tree rooted at this node
+				int tree_count;
 
 				// The left and right sub-trees
 				Node *left_tree;
@@ -22,29 +25,36 @@ class Search_tree {
 				Node( Type const & = Type() );
 
 				void update_height();
-				int BF();
+				void update_count();
+				int BF() const;
 
-				int height() const;
+				static int height( Node const * );
+				static int count( Node const * );
 				bool is_leaf() const;
-				Node *front();
-				Node *back();
 				Node *find( Type const &obj );
 
-				void clear();
-				bool insert( Type const &obj, Node *&to_this );
-				bool erase( Type const &obj, Node *&to_this );
-				void rotateRight( Node *&curr_node );
-				void rotateLeft( Node *&curr_node );
-				void balanceTree( Node *&curr_node );
+				static void rotateRight( Node *&curr_node );
+				static void rotateLeft( Node *&curr_node );
+				static void balanceTree( Node *&curr_node );
 
 		};
 
+		// An AVL tree of fewer than 2^31 nodes is less than 45 levels deep
+		static int const max_depth = 64;
+
 		Node *root_node;
 		int tree_size;
 		Node *front_sentinel;
 		Node *back_sentinel;
 
-		
+		void rebalance( Node **path[], int depth );
+		int count_before( Type const &obj, bool inclusive ) const;
+		Node *bound_node( Type const &obj, bool upper ) const;
+		void link_before( Node *next, Type const &obj );
+		void unlink( Node *node );
+		void rebuild();
+		static Node *build( Node *&next, int n );
+
 
 	public:
 		class Iterator {
@@ -82,10 +92,29 @@ class Search_tree {
 		Iterator rend();
 		Iterator find( Type const & );
 
+		// Range queries: the iterators are positioned on the list of nodes in order
+		Iterator lower_bound( Type const & );
+		Iterator upper_bound( Type const & );
+		std::pair<Iterator, Iterator> equal_range( Type const & );
+		template <typename Function>
+		void for_each_in_range( Type const &, Type const &, Function ) const;
+
+		// Order statistics, in O(log n)
+		Iterator select( int );
+		int rank( Type const & ) const;
+		int count_range( Type const &, Type const & ) const;
+
 		void clear();
 		bool insert( Type const & );
 		bool erase( Type const & );
 
+		// Bulk operations, in O(n + m)
+		template <typename Sorted_iterator>
+		void from_sorted( Sorted_iterator, Sorted_iterator );
+		void union_with( Search_tree const & );
+		void intersect( Search_tree const & );
+		void difference( Search_tree const & );
+
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -121,16 +150,17 @@ int Search_tree<Type>::size() const {
 
 template <typename Type>
 int Search_tree<Type>::height() const {
-	return root_node->height();
+	return Node::height( root_node );
 }
 
+// The nodes are linked in order between the sentinels, so the front and back are O(1)
 template <typename Type>
 Type Search_tree<Type>::front() const {
 	if ( empty() ) {
 		throw underflow();
 	}
 
-	return root_node->front()->node_value;
+	return front_sentinel->next_node->node_value;
 }
 
 template <typename Type>
@@ -139,12 +169,12 @@ Type Search_tree<Type>::back() const {
 		throw underflow();
 	}
 
-	return root_node->back()->node_value;
+	return back_sentinel->previous_node->node_value;
 }
 
 template <typename Type>
 typename Search_tree<Type>::Iterator Search_tree<Type>::begin() {
-	return empty() ? Iterator( this, back_sentinel ) : Iterator( this, root_node->front() );
+	return Iterator( this, front_sentinel->next_node );
 }
 
 template <typename Type>
@@ -154,7 +184,7 @@ typename Search_tree<Type>::Iterator Search_tree<Type>::end() {
 
 template <typename Type>
 typename Search_tree<Type>::Iterator Search_tree<Type>::rbegin() {
-	return empty() ? Iterator( this, front_sentinel ) : Iterator( this, root_node->back() );
+	return Iterator( this, back_sentinel->previous_node );
 }
 
 template <typename Type>
@@ -177,238 +207,525 @@ typename Search_tree<Type>::Iterator Search_tree<Type>::find( Type const &obj )
 	}
 }
 
+// Return an iterator to the first element not less than obj, or end() if there is none
+template <typename Type>
+typename Search_tree<Type>::Iterator Search_tree<Type>::lower_bound( Type const &obj ) {
+	return Iterator( this, bound_node( obj, false ) );
+}
+
+// Return an iterator to the first element greater than obj, or end() if there is none
+template <typename Type>
+typename Search_tree<Type>::Iterator Search_tree<Type>::upper_bound( Type const &obj ) {
+	return Iterator( this, bound_node( obj, true ) );
+}
+
+// Return the range of elements equal to obj (empty, or the one element equal to obj)
+template <typename Type>
+std::pair<typename Search_tree<Type>::Iterator, typename Search_tree<Type>::Iterator> Search_tree<Type>::equal_range( Type const &obj ) {
+	Node *first = bound_node( obj, false );
+
+	if ( first != back_sentinel && !( obj < first->node_value ) ) {
+		return std::make_pair( Iterator( this, first ), Iterator( this, first->next_node ) );
+	} else {
+		return std::make_pair( Iterator( this, first ), Iterator( this, first ) );
+	}
+}
+
+// Call f( x ) for each element x with lo <= x <= hi, in order: one descent to the first
+// element, then a walk along the list of nodes
+template <typename Type>
+template <typename Function>
+void Search_tree<Type>::for_each_in_range( Type const &lo, Type const &hi, Function f ) const {
+	for ( Node const *curr_node = bound_node( lo, false );
+	      curr_node != back_sentinel && !( hi < curr_node->node_value );
+	      curr_node = curr_node->next_node ) {
+		f( curr_node->node_value );
+	}
+}
+
+// Return an iterator to the element with k elements before it (the (k + 1)-th smallest),
+// or end() if k is not in [0, size()), going down by the sizes of the left sub-trees
+template <typename Type>
+typename Search_tree<Type>::Iterator Search_tree<Type>::select( int k ) {
+	if ( k < 0 || k >= tree_size ) {
+		return end();
+	}
+
+	Node *curr_node = root_node;
+
+	while ( true ) {
+		int left_count = Node::count( curr_node->left_tree );
+
+		if ( k < left_count ) {
+			curr_node = curr_node->left_tree;
+		} else if ( k > left_count ) {
+			k -= left_count + 1;
+			curr_node = curr_node->right_tree;
+		} else {
+			return Iterator( this, curr_node );
+		}
+	}
+}
+
+// Return the number of elements less than obj (obj need not be in the tree)
+template <typename Type>
+int Search_tree<Type>::rank( Type const &obj ) const {
+	return count_before( obj, false );
+}
+
+// Return the number of elements x with a <= x <= b
+template <typename Type>
+int Search_tree<Type>::count_range( Type const &a, Type const &b ) const {
+	if ( b < a ) {
+		return 0;
+	}
+
+	return count_before( b, true ) - count_before( a, false );
+}
+
+// Delete the nodes by walking the list between the sentinels (no recursion)
 template <typename Type>
 void Search_tree<Type>::clear() {
-	if ( !empty() ) {
-		root_node->clear();
-		root_node = nullptr;
-		tree_size = 0;
+	Node *curr_node = front_sentinel->next_node;
+
+	while ( curr_node != back_sentinel ) {
+		Node *next = curr_node->next_node;
+		delete curr_node;
+		curr_node = next;
 	}
 
+	root_node = nullptr;
+	tree_size = 0;
+
 	// Reinitialize the sentinels
 	front_sentinel->next_node = back_sentinel;
 	back_sentinel->previous_node = front_sentinel;
 }
 
+// Insert obj without recursion: walk down to the empty link where obj belongs,
+// remembering the links on the way, then rebalance bottom-up along that path
 template <typename Type>
 bool Search_tree<Type>::insert( Type const &obj ) {
-	if ( empty() ) {
-		root_node = new Search_tree::Node( obj );
-		tree_size = 1;
-		front_sentinel->next_node = root_node;
-		root_node->previous_node = front_sentinel;
-		root_node->next_node = back_sentinel;
-		back_sentinel->previous_node = root_node;
-
-		return true;
-	} else if ( root_node->insert( obj, root_node ) ) {
-		++tree_size;
-		return true;
-	} else {
-		return false;
+	Node **path[max_depth];
+	int depth = 0;
+	Node **link = &root_node;
+	// The node that follows obj in order: the last node where the walk turned left
+	Node *next = back_sentinel;
+
+	while ( *link != nullptr ) {
+		if ( obj < (*link)->node_value ) {
+			next = *link;
+			path[depth++] = link;
+			link = &(*link)->left_tree;
+		} else if ( obj > (*link)->node_value ) {
+			path[depth++] = link;
+			link = &(*link)->right_tree;
+		} else {
+			return false;
+		}
 	}
+
+	link_before( next, obj );
+	*link = next->previous_node;
+
+	rebalance( path, depth );
+	return true;
 }
 
+// Erase obj without recursion. A node with two sub-trees is replaced by its successor
+// (the front of its right sub-tree), which is relinked rather than copied, so the other
+// nodes (and iterators to them) are unchanged
 template <typename Type>
 bool Search_tree<Type>::erase( Type const &obj ) {
-	if ( !empty() && root_node->erase( obj, root_node ) ) {
-		--tree_size;
-		return true;
-	} else {
+	Node **path[max_depth];
+	int depth = 0;
+	Node **link = &root_node;
+
+	while ( *link != nullptr ) {
+		if ( obj < (*link)->node_value ) {
+			path[depth++] = link;
+			link = &(*link)->left_tree;
+		} else if ( obj > (*link)->node_value ) {
+			path[depth++] = link;
+			link = &(*link)->right_tree;
+		} else {
+			break;
+		}
+	}
+
+	if ( *link == nullptr ) {
 		return false;
 	}
-}
 
-//////////////////////////////////////////////////////////////////////
-//                   Node Public Member Functions                   //
-//////////////////////////////////////////////////////////////////////
+	Node *to_erase = *link;
+	to_erase->next_node->previous_node = to_erase->previous_node;
+	to_erase->previous_node->next_node = to_erase->next_node;
 
-template <typename Type>
-Search_tree<Type>::Node::Node( Type const &obj ):
-node_value( obj ),
-left_tree( nullptr ),
-right_tree( nullptr ),
-next_node( nullptr ),
-previous_node( nullptr ),
-tree_height( 0 ) {
-	// does nothing
+	if ( to_erase->left_tree == nullptr ) {
+		*link = to_erase->right_tree;
+	} else if ( to_erase->right_tree == nullptr ) {
+		*link = to_erase->left_tree;
+	} else {
+		path[depth++] = link;
+		int successor_depth = depth;
+		Node **successor_link = &to_erase->right_tree;
+
+		while ( (*successor_link)->left_tree != nullptr ) {
+			path[depth++] = successor_link;
+			successor_link = &(*successor_link)->left_tree;
+		}
+
+		Node *successor = *successor_link;
+		*successor_link = successor->right_tree;
+		successor->left_tree = to_erase->left_tree;
+		successor->right_tree = to_erase->right_tree;
+		successor->tree_height = to_erase->tree_height;
+		successor->tree_count = to_erase->tree_count;
+		*link = successor;
+
+		// The link below the successor on the path moved from to_erase to the successor
+		if ( depth > successor_depth ) {
+			path[successor_depth] = &successor->right_tree;
+		}
+	}
+
+	delete to_erase;
+	--tree_size;
+	rebalance( path, depth );
+	return true;
 }
 
+// Replace the elements by those in [first, last), which must be sorted in increasing order
+// (repeated values are inserted once). The nodes are created in order on the list, and
+// the tree is then built over them, perfectly balanced, in O(n): no descents or rotations.
+// An illegal argument error is thrown (and the tree is left empty) if the values are not sorted
 template <typename Type>
-void Search_tree<Type>::Node::update_height() {
-	tree_height = std::max( left_tree->height(), right_tree->height() ) + 1;
+template <typename Sorted_iterator>
+void Search_tree<Type>::from_sorted( Sorted_iterator first, Sorted_iterator last ) {
+	clear();
+
+	try {
+		for ( ; first != last; ++first ) {
+			Node *back = back_sentinel->previous_node;
+
+			if ( back != front_sentinel ) {
+				if ( *first < back->node_value ) {
+					throw illegal_argument();
+				} else if ( !( back->node_value < *first ) ) {
+					continue;
+				}
+			}
+
+			link_before( back_sentinel, *first );
+		}
+	} catch (...) {
+		// clear() only walks the list, so it also deletes the nodes not yet in the tree
+		clear();
+		throw;
+	}
+
+	rebuild();
 }
 
+// Add the elements of other. The two lists of nodes are merged in one pass, and the tree is
+// rebuilt over the merged list; the nodes of this tree are kept. This is O(n + m) even when
+// other is much smaller than this tree, where a join-based union (splitting this tree by the
+// keys of other) is O(m log(n/m + 1)). Only when m descents cost less than the merge, that is
+// when m*height < n, are the elements of other inserted one at a time, in O(m log n).
+// The merge is a single walk along the two lists, each step starting where the previous one
+// stopped, so it has no independent halves to fork on a Task_group (2_Work_stealing_deque.h);
+// only the split/join recursion of a join-based union could be run in parallel that way
 template <typename Type>
-int Search_tree<Type>::Node::BF() {
-	return ( ((right_tree)?right_tree->tree_height + 1: 0) - ((left_tree) ? left_tree->tree_height + 1: 0) );
+void Search_tree<Type>::union_with( Search_tree const &other ) {
+	if ( &other == this || other.empty() ) {
+		return;
+	}
+
+	if ( static_cast<long long>( other.tree_size )*( height() + 2 ) < tree_size ) {
+		for ( Node const *from = other.front_sentinel->next_node; from != other.back_sentinel; from = from->next_node ) {
+			insert( from->node_value );
+		}
+
+		return;
+	}
+
+	Node *curr_node = front_sentinel->next_node;
+	Node const *from = other.front_sentinel->next_node;
+
+	try {
+		while ( from != other.back_sentinel ) {
+			if ( curr_node != back_sentinel && curr_node->node_value < from->node_value ) {
+				curr_node = curr_node->next_node;
+			} else {
+				if ( curr_node == back_sentinel || from->node_value < curr_node->node_value ) {
+					link_before( curr_node, from->node_value );
+				}
+
+				from = from->next_node;
+			}
+		}
+	} catch (...) {
+		rebuild();
+		throw;
+	}
+
+	rebuild();
 }
 
+// Keep only the elements that are also in other: one pass over the two lists, then a rebuild,
+// in O(n + m) (see union_with())
 template <typename Type>
-int Search_tree<Type>::Node::height() const {
-	return ( this == nullptr ) ? -1 : tree_height;
+void Search_tree<Type>::intersect( Search_tree const &other ) {
+	if ( &other == this ) {
+		return;
+	}
+
+	Node *curr_node = front_sentinel->next_node;
+	Node const *from = other.front_sentinel->next_node;
+
+	while ( curr_node != back_sentinel ) {
+		if ( from == other.back_sentinel || curr_node->node_value < from->node_value ) {
+			Node *next = curr_node->next_node;
+			unlink( curr_node );
+			curr_node = next;
+		} else {
+			if ( !( from->node_value < curr_node->node_value ) ) {
+				curr_node = curr_node->next_node;
+			}
+
+			from = from->next_node;
+		}
+	}
+
+	rebuild();
 }
 
-// Return true if the current node is a leaf node, false otherwise
+// Remove the elements that are in other: one pass over the two lists, then a rebuild, in
+// O(n + m), or m erasures in O(m log n) if m*height < n (as in union_with())
 template <typename Type>
-bool Search_tree<Type>::Node::is_leaf() const {
-	return ( (left_tree == nullptr) && (right_tree == nullptr) );
+void Search_tree<Type>::difference( Search_tree const &other ) {
+	if ( &other == this ) {
+		clear();
+		return;
+	}
+
+	if ( other.empty() ) {
+		return;
+	}
+
+	if ( static_cast<long long>( other.tree_size )*( height() + 2 ) < tree_size ) {
+		for ( Node const *from = other.front_sentinel->next_node; from != other.back_sentinel; from = from->next_node ) {
+			erase( from->node_value );
+		}
+
+		return;
+	}
+
+	Node *curr_node = front_sentinel->next_node;
+	Node const *from = other.front_sentinel->next_node;
+
+	while ( curr_node != back_sentinel && from != other.back_sentinel ) {
+		if ( curr_node->node_value < from->node_value ) {
+			curr_node = curr_node->next_node;
+		} else if ( from->node_value < curr_node->node_value ) {
+			from = from->next_node;
+		} else {
+			Node *next = curr_node->next_node;
+			unlink( curr_node );
+			curr_node = next;
+			from = from->next_node;
+		}
+	}
+
+	rebuild();
 }
 
-// Return a pointer to the front node
+//////////////////////////////////////////////////////////////////////
+//               Search Tree Private Member Functions               //
+//////////////////////////////////////////////////////////////////////
+
+// Create a node for obj and link it before next in the list (not in the tree)
 template <typename Type>
-typename Search_tree<Type>::Node *Search_tree<Type>::Node::front() {
-	return ( left_tree == nullptr ) ? this : left_tree->front();
+void Search_tree<Type>::link_before( Node *next, Type const &obj ) {
+	Node *new_node = new Search_tree::Node( obj );
+
+	new_node->next_node = next;
+	new_node->previous_node = next->previous_node;
+	next->previous_node->next_node = new_node;
+	next->previous_node = new_node;
+	++tree_size;
 }
 
-// Return a pointer to the back node
+// Unlink a node from the list and delete it (the tree must be rebuilt)
 template <typename Type>
-typename Search_tree<Type>::Node *Search_tree<Type>::Node::back() {
-	return ( right_tree == nullptr ) ? this : right_tree->back();
+void Search_tree<Type>::unlink( Node *node ) {
+	node->next_node->previous_node = node->previous_node;
+	node->previous_node->next_node = node->next_node;
+	delete node;
+	--tree_size;
 }
 
+// Build the tree over the tree_size nodes of the list
 template <typename Type>
-typename Search_tree<Type>::Node *Search_tree<Type>::Node::find( Type const &obj ) {
-	if ( obj == node_value ) {
-		return this;
-	} else if ( obj < node_value ) {
-		return (left_tree == nullptr) ? nullptr : left_tree->find( obj );
-	} else {
-		return ( right_tree == nullptr ) ? nullptr : right_tree->find( obj );
-	}
+void Search_tree<Type>::rebuild() {
+	Node *next = front_sentinel->next_node;
+	root_node = build( next, tree_size );
 }
 
-// Recursively clear the tree
+// Build a perfectly balanced tree over the next n nodes of the list, and advance next past
+// them. The sizes of two sibling sub-trees differ by at most one, so it is an AVL tree, and
+// the recursion is only log2(n) deep
 template <typename Type>
-void Search_tree<Type>::Node::clear() {
-	if ( left_tree != nullptr ) {
-		left_tree->clear();
+typename Search_tree<Type>::Node *Search_tree<Type>::build( Node *&next, int n ) {
+	if ( n == 0 ) {
+		return nullptr;
 	}
 
-	if ( right_tree != nullptr ) {
-		right_tree->clear();
-	}
+	Node *left = build( next, n/2 );
+	Node *curr_node = next;
+	next = next->next_node;
 
-	delete this;
+	curr_node->left_tree = left;
+	curr_node->right_tree = build( next, n - n/2 - 1 );
+	curr_node->update_height();
+	curr_node->update_count();
+
+	return curr_node;
 }
 
+// Update and balance the sub-trees on the path, from the bottom up. A sub-tree whose
+// height has not changed leaves the balance of its ancestors unchanged, so stop there;
+// only the sizes of the sub-trees above still have to be updated
 template <typename Type>
-bool Search_tree<Type>::Node::insert( Type const &obj, Search_tree<Type>::Node *&to_this ) {
-	if ( obj < node_value ) {
-		if ( left_tree == nullptr ) {
-			left_tree = new Search_tree<Type>::Node( obj );
-			update_height();
+void Search_tree<Type>::rebalance( Node **path[], int depth ) {
+	while ( depth > 0 ) {
+		Node *&curr_node = *path[--depth];
+		int old_height = curr_node->tree_height;
 
-			left_tree->previous_node = to_this->previous_node;
-			left_tree->next_node = to_this;
-			to_this->previous_node->next_node = left_tree;
-			to_this->previous_node = left_tree;
-			balanceTree(to_this);
-			return true;
-		} else {
-			if ( left_tree->insert( obj, left_tree ) ) {
-				update_height();
-				balanceTree(to_this);
-				return true;
-			} else {
-				balanceTree(to_this);
-				return false;
-			}
+		Node::balanceTree( curr_node );
+
+		if ( curr_node->tree_height == old_height ) {
+			break;
 		}
-	} else if ( obj > node_value ) {
-		if ( right_tree == nullptr ) {
-			right_tree = new Search_tree<Type>::Node( obj );
-			update_height();
+	}
+
+	while ( depth > 0 ) {
+		(*path[--depth])->update_count();
+	}
+}
 
-			right_tree->previous_node = to_this;
-			right_tree->next_node = to_this->next_node;
-			to_this->next_node->previous_node = right_tree;
-			to_this->next_node = right_tree;
+// Return the first node whose value is not less than obj (greater than obj, if upper),
+// or the back sentinel if there is none
+template <typename Type>
+typename Search_tree<Type>::Node *Search_tree<Type>::bound_node( Type const &obj, bool upper ) const {
+	Node *result = back_sentinel;
+	Node *curr_node = root_node;
 
-			return true;
+	while ( curr_node != nullptr ) {
+		if ( obj < curr_node->node_value || ( !upper && !( obj > curr_node->node_value ) ) ) {
+			result = curr_node;
+			curr_node = curr_node->left_tree;
 		} else {
-			if ( right_tree->insert( obj, right_tree ) ) {
-				update_height();
-				balanceTree(to_this);
-				return true;
-			} else {
-				balanceTree(to_this);
-				return false;
-			}
+			curr_node = curr_node->right_tree;
 		}
-	} else {
-		return false;
 	}
+
+	return result;
 }
 
+// Return the number of elements less than obj (or equal to it, if inclusive)
 template <typename Type>
-bool Search_tree<Type>::Node::erase( Type const &obj, Search_tree<Type>::Node *&to_this ) {
-	if ( obj < node_value ) {
-		if ( left_tree == nullptr ) {
-			return false;
-		} else {
-			if ( left_tree->erase( obj, left_tree ) ) {
-				update_height();
-				balanceTree();
-				return true;
-			}
+int Search_tree<Type>::count_before( Type const &obj, bool inclusive ) const {
+	int result = 0;
+	Node const *curr_node = root_node;
 
-			return false;
-		}
-	} else if ( obj > node_value ) {
-		if ( right_tree == nullptr ) {
-			return false;
+	while ( curr_node != nullptr ) {
+		if ( obj > curr_node->node_value || ( inclusive && !( obj < curr_node->node_value ) ) ) {
+			result += Node::count( curr_node->left_tree ) + 1;
+			curr_node = curr_node->right_tree;
 		} else {
-			if ( right_tree->erase( obj, right_tree ) ) {
-				update_height();
-				balanceTree();
-				return true;
-			}
-
-			return false;
+			curr_node = curr_node->left_tree;
 		}
-	} else {
-		assert( obj == node_value );
+	}
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////
+//                   Node Public Member Functions                   //
+//////////////////////////////////////////////////////////////////////
+
+template <typename Type>
+Search_tree<Type>::Node::Node( Type const &obj ):
+node_value( obj ),
+tree_height( 0 ),
+tree_count( 1 ),
+left_tree( nullptr ),
+right_tree( nullptr ),
+previous_node( nullptr ),
+next_node( nullptr ) {
+	// does nothing
+}
 
-		if ( is_leaf() ) {
+template <typename Type>
+void Search_tree<Type>::Node::update_height() {
+	tree_height = std::max( height( left_tree ), height( right_tree ) ) + 1;
+}
 
-			to_this->next_node->previous_node = to_this->previous_node;
-			to_this->previous_node->next_node = to_this->next_node;
+template <typename Type>
+void Search_tree<Type>::Node::update_count() {
+	tree_count = count( left_tree ) + count( right_tree ) + 1;
+}
 
-			to_this = nullptr;
-			delete this;
-		} else if ( left_tree == nullptr ) {
+template <typename Type>
+int Search_tree<Type>::Node::BF() const {
+	return height( right_tree ) - height( left_tree );
+}
 
-			to_this->next_node->previous_node = to_this->previous_node;
-			to_this->previous_node->next_node = to_this->next_node;
+// The height of an empty sub-tree is -1
+template <typename Type>
+int Search_tree<Type>::Node::height( Node const *node ) {
+	return ( node == nullptr ) ? -1 : node->tree_height;
+}
 
-			to_this = right_tree;
-			delete this;
-		} else if ( right_tree == nullptr ) {
+template <typename Type>
+int Search_tree<Type>::Node::count( Node const *node ) {
+	return ( node == nullptr ) ? 0 : node->tree_count;
+}
 
-			to_this->next_node->previous_node = to_this->previous_node;
-			to_this->previous_node->next_node = to_this->next_node;
+// Return true if the current node is a leaf node, false otherwise
+template <typename Type>
+bool Search_tree<Type>::Node::is_leaf() const {
+	return ( (left_tree == nullptr) && (right_tree == nullptr) );
+}
 
-			to_this = left_tree;
-			delete this;
+template <typename Type>
+typename Search_tree<Type>::Node *Search_tree<Type>::Node::find( Type const &obj ) {
+	Node *curr_node = this;
 
+	while ( curr_node != nullptr ) {
+		if ( obj < curr_node->node_value ) {
+			curr_node = curr_node->left_tree;
+		} else if ( obj > curr_node->node_value ) {
+			curr_node = curr_node->right_tree;
 		} else {
-			
-			node_value = right_tree->front()->node_value;
-			right_tree->erase( node_value, right_tree );
-			balanceTree();
-			update_height();
+			return curr_node;
 		}
-
-		return true;
 	}
+
+	return nullptr;
 }
 
+// The rotations update the heights and sizes of the two nodes that move
 template <typename Type>
 void Search_tree<Type>::Node::rotateRight( Node *&curr_node ) {
 	auto temp = curr_node->left_tree;
 	curr_node->left_tree = temp->right_tree;
 	temp->right_tree = curr_node;
+	curr_node->update_height();
+	curr_node->update_count();
+	temp->update_height();
+	temp->update_count();
 	curr_node = temp;
 
 }
@@ -418,24 +735,29 @@ void Search_tree<Type>::Node::rotateLeft( Node *&curr_node ) {
 	auto temp = curr_node->right_tree;
 	curr_node->right_tree = temp->left_tree;
 	temp->left_tree = curr_node;
+	curr_node->update_height();
+	curr_node->update_count();
+	temp->update_height();
+	temp->update_count();
 	curr_node = temp;
 	
 }
 
+// Update the height and size of curr_node, and rotate if its sub-trees differ in height by two
 template <typename Type>
 void Search_tree<Type>::Node::balanceTree( Node *&curr_node ) {
 	curr_node->update_height();
-	if(curr_node->BF() < -1){
+	curr_node->update_count();
+	int balance = curr_node->BF();
+
+	if(balance < -1){
 		if (curr_node->left_tree->BF() > 0) rotateLeft(curr_node->left_tree);
 		rotateRight(curr_node);
 	}
-	else if(curr_node->BF() > 1){
+	else if(balance > 1){
 		if(curr_node->right_tree->BF() < 0) rotateRight(curr_node->right_tree);
 		rotateLeft(curr_node);
 	}
-	if(curr_node->right_tree) curr_node->right_tree->update_height();
-	if(curr_node->left_tree) curr_node->left_tree->update_height();
-	curr_node->update_height();
 }
 
 
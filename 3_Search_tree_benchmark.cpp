@@ -0,0 +1,120 @@
+// Benchmark of Search_tree insert, find and erase against std::set, from a million to a
+// hundred million keys.
+//
+// Build:	g++ -std=c++17 -O2 3_Search_tree_benchmark.cpp -o tree_benchmark
+// Run:		./tree_benchmark [key counts (default 1000000 10000000 100000000)]
+//
+// For each number of keys n, each container is filled with n distinct random keys
+// (insert), searched for n keys of which half are present (find) and emptied by erasing
+// the keys in another random order (erase). A second container is then filled with the keys
+// in increasing order and cleared (sorted), the case where a recursive clear() is deepest.
+// Times are in nanoseconds per key. A hundred million keys need about 10 GB of memory.
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+// The exceptions thrown by the tree
+class underflow {};
+class overflow {};
+class illegal_argument {};
+
+#include "3_Search_tree.h"
+
+static double elapsed( std::chrono::steady_clock::time_point start ) {
+	return std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Keeps the compiler from dropping the results
+static volatile long sink;
+
+/*
+	The adapters give both containers one interface for the tests
+*/
+static bool contains( Search_tree<std::uint64_t> &tree, std::uint64_t key ) { return tree.find( key ) != tree.end(); }
+static bool contains( std::set<std::uint64_t> &tree, std::uint64_t key ) { return tree.find( key ) != tree.end(); }
+
+/*
+	keys returns n distinct random keys: the odd numbers 2k + 1 for k < n, shuffled. The
+	even numbers are the keys that find does not find.
+*/
+static std::vector<std::uint64_t> keys( long n, std::mt19937_64 &random ) {
+	std::vector<std::uint64_t> result( n );
+	for ( long i = 0; i < n; ++i ) result[i] = 2*static_cast<std::uint64_t>( i ) + 1;
+	std::shuffle( result.begin(), result.end(), random );
+	return result;
+}
+
+template <typename Tree>
+void run( std::string const &name, long n, std::vector<std::uint64_t> const &inserted,
+          std::vector<std::uint64_t> const &searched, std::vector<std::uint64_t> const &erased ) {
+	double insert_ns, find_ns, erase_ns, sorted_ns;
+	long found = 0;
+
+	{
+		Tree tree;
+
+		auto start = std::chrono::steady_clock::now();
+		for ( std::uint64_t key: inserted ) tree.insert( key );
+		insert_ns = elapsed( start )/n;
+
+		start = std::chrono::steady_clock::now();
+		for ( std::uint64_t key: searched ) found += contains( tree, key );
+		find_ns = elapsed( start )/n;
+
+		start = std::chrono::steady_clock::now();
+		for ( std::uint64_t key: erased ) tree.erase( key );
+		erase_ns = elapsed( start )/n;
+	}
+
+	{
+		auto start = std::chrono::steady_clock::now();
+		{
+			Tree tree;
+			for ( long i = 0; i < n; ++i ) tree.insert( static_cast<std::uint64_t>( i ) );
+			tree.clear();
+		}
+		sorted_ns = elapsed( start )/n;
+	}
+
+	sink = found;
+
+	std::cout << std::left << std::setw( 14 ) << name << std::right << std::setw( 12 ) << n
+	          << std::fixed << std::setprecision( 1 )
+	          << std::setw( 10 ) << insert_ns << std::setw( 10 ) << find_ns
+	          << std::setw( 10 ) << erase_ns << std::setw( 10 ) << sorted_ns << std::endl;
+}
+
+int main( int argc, char **argv ) {
+	std::vector<long> sizes;
+	for ( int i = 1; i < argc; ++i ) sizes.push_back( std::atol( argv[i] ) );
+	if ( sizes.empty() ) sizes = { 1000000, 10000000, 100000000 };
+
+	std::cout << "ns per key" << std::endl
+	          << std::left << std::setw( 14 ) << "tree" << std::right << std::setw( 12 ) << "keys"
+	          << std::setw( 10 ) << "insert" << std::setw( 10 ) << "find"
+	          << std::setw( 10 ) << "erase" << std::setw( 10 ) << "sorted" << std::endl;
+
+	for ( long n: sizes ) {
+		std::mt19937_64 random( 42 );
+		std::vector<std::uint64_t> inserted = keys( n, random );
+
+		// Half of the searched keys are present (odd) and half are not (even)
+		std::vector<std::uint64_t> searched( n );
+		for ( long i = 0; i < n; ++i ) searched[i] = ( i % 2 == 0 ) ? inserted[i] : inserted[i] - 1;
+
+		std::vector<std::uint64_t> erased( inserted );
+		std::shuffle( erased.begin(), erased.end(), random );
+
+		run<Search_tree<std::uint64_t>>( "Search_tree", n, inserted, searched, erased );
+		run<std::set<std::uint64_t>>( "std::set", n, inserted, searched, erased );
+	}
+
+	return 0;
+}